@@ -0,0 +1,319 @@
+#!/usr/bin/env python3
+# Copyright © 2026 Mesa contributors
+# SPDX-License-Identifier: MIT
+
+"""Offline shader statistics for ir3 and RADV/ACO.
+
+Compiles a corpus of shaders for a list of GPUs without any hardware, using
+the ir3_compiler standalone tool for Adreno and radv_compile_bench (RADV on
+its null winsys) for AMD, and reports instruction counts, register usage,
+spills, estimated cycles and compile time for every shader.
+
+    $ bin/shader-stats.py --ir3 630,660 --radv navi21 -j 16 \\
+          --format json -o before.json shaders/
+    ... rebuild with your change ...
+    $ bin/shader-stats.py --ir3 630,660 --radv navi21 -j 16 \\
+          --baseline before.json shaders/
+
+GLSL (.vert/.frag/.comp) and SPIR-V (.spv, entrypoint "main") shaders are
+compiled for ir3; RADV only takes SPIR-V compute shaders.
+
+Estimated cycles come from the latency model of each GPU (ir3_info::cycles
+for ir3, the ACO "Latency" statistic for RADV).  To evaluate a scheduler
+change such as IR3_SHADER_DEBUG=ilpsched, compare a run with it set against
+a baseline run without it.
+"""
+
+import argparse
+import concurrent.futures
+import csv
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+METRICS = ['instructions', 'gprs', 'spills', 'cycles', 'compile_ms']
+
+IR3_EXTENSIONS = ('.vert', '.frag', '.comp', '.spv')
+RADV_EXTENSIONS = ('.spv',)
+
+IR3_INSTR_RE = re.compile(r'^; \w+ prog \d+/\d+: (\d+) instr, (\d+) nops, '
+                          r'(\d+) non-nops, (\d+) mov, (\d+) cov, (\d+) dwords$')
+IR3_REGS_RE = re.compile(r'^; \w+ prog \d+/\d+: (\d+) last-baryf, (\d+) last-helper, '
+                         r'(-?\d+) half, (-?\d+) full, (\d+) constlen$')
+IR3_SYNC_RE = re.compile(r'^; \w+ prog \d+/\d+: (\d+) sstall, (\d+) \(ss\), '
+                         r'(\d+) systall, (\d+) \(sy\), (-?\d+) loops$')
+IR3_TIME_RE = re.compile(r'^; \w+: (\d+) pvtmem, (\d+) cycles, ([0-9.]+) ms compile$')
+
+
+def find_tool(name: str, path: str | None) -> str | None:
+    if path:
+        return path
+    found = shutil.which(name)
+    if found:
+        return found
+    # Fall back to a build directory next to the source tree.
+    for build in ('build', '_build'):
+        for sub in ('src/gallium/drivers/freedreno', 'src/amd/vulkan'):
+            candidate = os.path.join(os.path.dirname(__file__), '..', build, sub, name)
+            if os.access(candidate, os.X_OK):
+                return os.path.normpath(candidate)
+    return None
+
+
+def collect_shaders(paths: list[str], extensions: tuple[str, ...]) -> list[str]:
+    shaders = []
+    for path in paths:
+        if os.path.isfile(path):
+            if path.endswith(extensions):
+                shaders.append(path)
+            continue
+        for root, _, files in os.walk(path):
+            shaders.extend(os.path.join(root, f) for f in files if f.endswith(extensions))
+    return sorted(shaders)
+
+
+def record(driver: str, target: str, filename: str, result: str) -> dict:
+    return {'driver': driver, 'target': target, 'file': filename, 'result': result}
+
+
+def run_ir3(compiler: str, gpu: str, filename: str) -> dict:
+    args = [compiler, '-g', gpu, filename]
+    if filename.endswith('.spv'):
+        args.append('main')
+
+    res = record('ir3', gpu, filename, 'failed')
+    try:
+        proc = subprocess.run(args, capture_output=True, text=True, timeout=600)
+    except subprocess.TimeoutExpired:
+        res['result'] = 'timeout'
+        return res
+    if proc.returncode != 0:
+        lines = proc.stderr.strip().splitlines()
+        res['error'] = lines[-1] if lines else f'exit code {proc.returncode}'
+        return res
+
+    stats = {}
+    for line in proc.stdout.splitlines():
+        if m := IR3_INSTR_RE.match(line):
+            stats.update(zip(['instr', 'nops', 'non-nops', 'mov', 'cov', 'dwords'],
+                             map(int, m.groups())))
+        elif m := IR3_REGS_RE.match(line):
+            stats.update(zip(['last-baryf', 'last-helper', 'half', 'full', 'constlen'],
+                             map(int, m.groups())))
+        elif m := IR3_SYNC_RE.match(line):
+            stats.update(zip(['sstall', '(ss)', 'systall', '(sy)', 'loops'],
+                             map(int, m.groups())))
+        elif m := IR3_TIME_RE.match(line):
+            stats['pvtmem'] = int(m.group(1))
+            stats['cycles'] = int(m.group(2))
+            stats['compile_ms'] = float(m.group(3))
+
+    if 'instr' not in stats:
+        res['error'] = 'no statistics in ir3_compiler output'
+        return res
+
+    res['result'] = 'ok'
+    res['instructions'] = stats['instr']
+    res['gprs'] = stats['full']
+    # ir3 spills to private memory; any pvtmem is spilling or scratch arrays.
+    res['spills'] = stats.get('pvtmem', 0)
+    res['cycles'] = stats.get('cycles', 0)
+    res['compile_ms'] = stats.get('compile_ms', 0.0)
+    res['stats'] = stats
+    return res
+
+
+def run_radv(bench: str, family: str, shaders: list[str], jobs: int) -> list[dict]:
+    args = [bench, '-f', family, '-j', str(jobs)] + shaders
+    proc = subprocess.run(args, capture_output=True, text=True)
+    if proc.returncode != 0 and not proc.stdout:
+        sys.exit(f'radv_compile_bench failed for {family}: {proc.stderr.strip()}')
+
+    results = []
+    for line in proc.stdout.splitlines():
+        data = json.loads(line)
+        if 'summary' in data:
+            continue
+
+        res = record('radv', family, data['file'], data['result'])
+        if data['result'] == 'ok':
+            stats = {}
+            for executable in data.get('executables', []):
+                for name, value in executable['statistics'].items():
+                    stats[f"{executable['name']}.{name}"] = value
+
+            def total(stat: str, combine=sum):
+                return combine(e['statistics'].get(stat, 0) for e in data['executables']) \
+                    if data.get('executables') else 0
+
+            res['instructions'] = total('Instructions')
+            res['gprs'] = total('VGPRs', max)
+            res['sgprs'] = total('SGPRs', max)
+            res['spills'] = total('Spilled SGPRs') + total('Spilled VGPRs')
+            res['cycles'] = total('Latency')
+            res['compile_ms'] = data['stage_ns'] / 1000000.0
+            res['stats'] = stats
+        results.append(res)
+    return results
+
+
+def key(res: dict) -> tuple[str, str, str]:
+    return (res['driver'], res['target'], res['file'])
+
+
+def load_results(filename: str) -> dict:
+    with open(filename) as f:
+        return {key(res): res for res in map(json.loads, f) if 'driver' in res}
+
+
+def write_json(results: list[dict], out) -> None:
+    for res in results:
+        out.write(json.dumps(res) + '\n')
+
+
+def write_csv(results: list[dict], out) -> None:
+    writer = csv.writer(out)
+    writer.writerow(['driver', 'target', 'file', 'result'] + METRICS)
+    for res in results:
+        writer.writerow([res['driver'], res['target'], res['file'], res['result']] +
+                        [res.get(m, '') for m in METRICS])
+
+
+def write_table(results: list[dict], out) -> None:
+    out.write(f"{'target':<12} {'instrs':>8} {'gprs':>6} {'spills':>8} {'cycles':>9} "
+              f"{'ms':>9}  file\n")
+    for res in results:
+        target = f"{res['driver']}:{res['target']}"
+        if res['result'] != 'ok':
+            out.write(f"{target:<12} {res['result']:>44}  {res['file']}\n")
+            continue
+        out.write(f"{target:<12} {res['instructions']:>8} {res['gprs']:>6} "
+                  f"{res['spills']:>8} {res['cycles']:>9} {res['compile_ms']:>9.3f}  "
+                  f"{res['file']}\n")
+
+
+def delta(before: float, after: float) -> str:
+    if before == after:
+        return '      '
+    if before == 0:
+        return '   new'
+    return f'{(after - before) * 100.0 / before:+5.1f}%'
+
+
+def write_comparison(results: list[dict], baseline: dict, out) -> None:
+    totals = {}
+    changed = []
+    for res in results:
+        old = baseline.get(key(res))
+        if res['result'] != 'ok' or not old or old['result'] != 'ok':
+            continue
+
+        target = totals.setdefault(f"{res['driver']}:{res['target']}",
+                                   {m: [0, 0] for m in METRICS} | {'shaders': 0, 'helped': 0, 'hurt': 0})
+        target['shaders'] += 1
+        for m in METRICS:
+            target[m][0] += old.get(m, 0)
+            target[m][1] += res.get(m, 0)
+
+        # Compile time is noisy, only the code quality metrics decide
+        # whether a shader was helped or hurt.
+        diff = [(m, old.get(m, 0), res.get(m, 0)) for m in METRICS[:-1]
+                if old.get(m, 0) != res.get(m, 0)]
+        if diff:
+            changed.append((res, diff))
+            if all(after < before for _, before, after in diff):
+                target['helped'] += 1
+            elif all(after > before for _, before, after in diff):
+                target['hurt'] += 1
+
+    for res, diff in changed:
+        out.write(f"{res['driver']}:{res['target']} {res['file']}:")
+        for m, before, after in diff:
+            out.write(f' {m} {before} -> {after} ({delta(before, after).strip()})')
+        out.write('\n')
+    if changed:
+        out.write('\n')
+
+    out.write(f"{'target':<12} {'metric':<13} {'before':>12} {'after':>12} {'delta':>7}\n")
+    for name, target in sorted(totals.items()):
+        for m in METRICS:
+            before, after = target[m]
+            if m == 'compile_ms':
+                out.write(f'{name:<12} {m:<13} {before:>12.3f} {after:>12.3f} {delta(before, after):>7}\n')
+            else:
+                out.write(f'{name:<12} {m:<13} {before:>12} {after:>12} {delta(before, after):>7}\n')
+        out.write(f"{name:<12} {target['shaders']} shaders compared, "
+                  f"{target['helped']} helped, {target['hurt']} hurt\n")
+
+    missing = [k for k in baseline if k not in {key(r) for r in results}]
+    if missing:
+        out.write(f'{len(missing)} shaders of the baseline were not compiled\n')
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('paths', nargs='+', help='shader files or directories to compile')
+    parser.add_argument('--ir3', default='', metavar='GPU_IDS',
+                        help='comma separated list of Adreno gpu-ids, e.g. 630,660')
+    parser.add_argument('--radv', default='', metavar='FAMILIES',
+                        help='comma separated list of AMD families, e.g. navi21,gfx1100')
+    parser.add_argument('--ir3-compiler', metavar='PATH', help='path to ir3_compiler')
+    parser.add_argument('--radv-compile-bench', metavar='PATH', help='path to radv_compile_bench')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(),
+                        help='number of shaders compiled in parallel (default: number of CPUs)')
+    parser.add_argument('--format', choices=['table', 'json', 'csv'], default='table',
+                        help='output format (default: table)')
+    parser.add_argument('-o', '--output', metavar='FILE', help='write the results to FILE')
+    parser.add_argument('--baseline', metavar='FILE',
+                        help='JSON output of a previous run to compare against')
+    args = parser.parse_args()
+
+    gpus = [g for g in args.ir3.split(',') if g]
+    families = [f for f in args.radv.split(',') if f]
+    if not gpus and not families:
+        parser.error('at least one of --ir3 or --radv is needed')
+
+    results = []
+
+    if gpus:
+        compiler = find_tool('ir3_compiler', args.ir3_compiler)
+        if not compiler:
+            parser.error('ir3_compiler not found, use --ir3-compiler')
+        shaders = collect_shaders(args.paths, IR3_EXTENSIONS)
+        with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as pool:
+            futures = [pool.submit(run_ir3, compiler, gpu, shader)
+                       for gpu in gpus for shader in shaders]
+            results.extend(f.result() for f in futures)
+
+    if families:
+        bench = find_tool('radv_compile_bench', args.radv_compile_bench)
+        if not bench:
+            parser.error('radv_compile_bench not found, use --radv-compile-bench')
+        shaders = collect_shaders(args.paths, RADV_EXTENSIONS)
+        for family in families:
+            if shaders:
+                results.extend(run_radv(bench, family, shaders, args.jobs))
+
+    results.sort(key=key)
+
+    out = open(args.output, 'w') if args.output else sys.stdout
+    if args.baseline:
+        write_comparison(results, load_results(args.baseline), out)
+    elif args.format == 'json':
+        write_json(results, out)
+    elif args.format == 'csv':
+        write_csv(results, out)
+    else:
+        write_table(results, out)
+    if out is not sys.stdout:
+        out.close()
+
+    return 1 if any(res['result'] != 'ok' for res in results) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -64,6 +64,8 @@ static const std::array<aco_compiler_statistic_info, aco_num_statistics> statist
    ret[aco_statistic_vmem] = aco_compiler_statistic_info{"VMEM", "Number of VMEM instructions"};
    ret[aco_statistic_smem] = aco_compiler_statistic_info{"SMEM", "Number of SMEM instructions"};
    ret[aco_statistic_vopd] = aco_compiler_statistic_info{"VOPD", "Number of VOPD instructions"};
+   ret[aco_statistic_ra_fast_path] = aco_compiler_statistic_info{
+      "RA Fast Path", "Register file increases made by RA instead of live-range splits"};
    return ret;
 }();
 
@@ -106,6 +108,28 @@ get_disasm_string(Program* program, std::vector<uint32_t>& code, unsigned exec_s
    return disasm;
 }
 
+static void
+reset_arena_stats()
+{
+   thread_arena_stats.peak_bytes = thread_arena_stats.bytes;
+   thread_arena_stats.num_buffers = 0;
+}
+
+static void
+print_arena_stats(Program* program)
+{
+   if (!(debug_flags & DEBUG_MEM_STATS))
+      return;
+
+   unsigned num_instructions = 0;
+   for (Block& block : program->blocks)
+      num_instructions += block.instructions.size();
+
+   fprintf(stderr, "ACO arena memory: %zu bytes peak, %u buffers, %zu blocks, %u instructions\n",
+           thread_arena_stats.peak_bytes, thread_arena_stats.num_buffers, program->blocks.size(),
+           num_instructions);
+}
+
 static std::string
 aco_postprocess_shader(const struct aco_compiler_options* options,
                        const struct aco_shader_info* info, std::unique_ptr<Program>& program)
@@ -168,6 +192,7 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
       validate(program.get());
 
       /* Register Allocation */
+      program->ra_fast_path = options->optimisations_disabled;
       register_allocation(program.get(), live_vars);
 
       if (validate_ra(program.get())) {
@@ -209,6 +234,8 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
    if (program->collect_statistics || (debug_flags & DEBUG_PERF_INFO))
       collect_preasm_stats(program.get());
 
+   print_arena_stats(program.get());
+
    return llvm_ir;
 }
 
@@ -225,6 +252,7 @@ aco_compile_shader_part(const struct aco_compiler_options* options,
                         bool is_prolog = false)
 {
    init();
+   reset_arena_stats();
 
    ac_shader_config config = {0};
    std::unique_ptr<Program> program{new Program};
@@ -266,6 +294,7 @@ aco_compile_shader(const struct aco_compiler_options* options, const struct aco_
                    const struct ac_shader_args* args, aco_callback* build_binary, void** binary)
 {
    init();
+   reset_arena_stats();
 
    ac_shader_config config = {0};
    std::unique_ptr<Program> program{new Program};
@@ -416,7 +445,8 @@ aco_get_codegen_flags()
    init();
    /* Exclude flags which don't affect code generation. */
    uint64_t exclude =
-      DEBUG_VALIDATE_IR | DEBUG_VALIDATE_RA | DEBUG_PERFWARN | DEBUG_PERF_INFO | DEBUG_LIVE_INFO;
+      DEBUG_VALIDATE_IR | DEBUG_VALIDATE_RA | DEBUG_PERFWARN | DEBUG_PERF_INFO | DEBUG_LIVE_INFO |
+      DEBUG_MEM_STATS;
    return debug_flags & ~exclude;
 }
 
@@ -59,6 +59,7 @@ enum {
    DEBUG_NO_VALIDATE_IR = 0x400,
    DEBUG_NO_SCHED_ILP = 0x800,
    DEBUG_NO_SCHED_VOPD = 0x1000,
+   DEBUG_MEM_STATS = 0x2000,
 };
 
 enum storage_class : uint8_t {
@@ -2021,6 +2022,10 @@ public:
 
    bool needs_vcc = false;
 
+   /* Make RA prefer growing the register file over live-range splits, as it does for very large
+    * shaders. */
+   bool ra_fast_path = false;
+
    CompilationProgress progress;
 
    bool collect_statistics = false;
@@ -2086,10 +2091,24 @@ private:
 };
 
 struct live {
+   /* arena holding the live-out sets */
+   std::unique_ptr<monotonic_buffer_resource> memory;
    /* live temps out per block */
    std::vector<IDSet> live_out;
    /* register demand (sgpr/vgpr) per instruction per block */
    std::vector<std::vector<RegisterDemand>> register_demand;
+
+   live() = default;
+   live(live&& other) = default;
+
+   live& operator=(live&& other)
+   {
+      /* The old live-out sets must be destroyed before their arena. */
+      live_out = std::move(other.live_out);
+      register_demand = std::move(other.register_demand);
+      memory = std::move(other.memory);
+      return *this;
+   }
 };
 
 struct ra_test_policy {
@@ -126,13 +126,13 @@ instr_needs_vcc(Instruction* instr)
 
 void
 process_live_temps_per_block(Program* program, live& lives, Block* block, unsigned& worklist,
-                             std::vector<PhiInfo>& phi_info)
+                             std::vector<PhiInfo>& phi_info, monotonic_buffer_resource& scratch)
 {
    std::vector<RegisterDemand>& register_demand = lives.register_demand[block->index];
    RegisterDemand new_demand;
 
    register_demand.resize(block->instructions.size());
-   IDSet live = lives.live_out[block->index];
+   IDSet live(lives.live_out[block->index], scratch);
 
    /* initialize register demand */
    for (unsigned t : live)
@@ -477,12 +477,17 @@ live
 live_var_analysis(Program* program)
 {
    live result;
-   result.live_out.resize(program->blocks.size());
+   result.memory.reset(new monotonic_buffer_resource());
+   result.live_out.resize(program->blocks.size(), IDSet(*result.memory));
    result.register_demand.resize(program->blocks.size());
    unsigned worklist = program->blocks.size();
    std::vector<PhiInfo> phi_info(program->blocks.size());
    RegisterDemand new_demand;
 
+   /* Blocks are usually visited several times, so the live set copies are made in an arena that is
+    * released after each block instead of going through the heap. */
+   monotonic_buffer_resource scratch;
+
    program->needs_vcc = program->gfx_level >= GFX10;
 
    /* this implementation assumes that the block idx corresponds to the block's position in
@@ -490,7 +495,8 @@ live_var_analysis(Program* program)
    while (worklist) {
       unsigned block_idx = --worklist;
       process_live_temps_per_block(program, result, &program->blocks[block_idx], worklist,
-                                   phi_info);
+                                   phi_info, scratch);
+      scratch.release();
    }
 
    /* Handle branches: we will insert copies created for linear phis just before the branch. */
@@ -94,6 +94,9 @@ struct ra_ctx {
    uint16_t vgpr_bounds;
    uint16_t num_linear_vgprs;
 
+   /* Trade register usage for compile time, see use_fast_path() */
+   bool fast_path;
+
    ra_test_policy policy;
 
    ra_ctx(Program* program_, ra_test_policy policy_)
@@ -108,6 +111,7 @@ struct ra_ctx {
       sgpr_bounds = program->max_reg_demand.sgpr;
       vgpr_bounds = program->max_reg_demand.vgpr;
       num_linear_vgprs = 0;
+      fast_path = false;
    }
 };
 
@@ -1824,6 +1828,14 @@ get_reg(ra_ctx& ctx, const RegisterFile& reg_file, Temp temp,
          return *res;
    }
 
+   /* Searching for live-range splits is the expensive part of RA, so huge shaders rather use more
+    * registers as long as that doesn't take them below the minimum number of waves. */
+   if (ctx.fast_path && increase_register_file(ctx, info.rc)) {
+      if (ctx.program->collect_statistics)
+         ctx.program->statistics[aco_statistic_ra_fast_path]++;
+      return get_reg(ctx, reg_file, temp, parallelcopies, instr, operand_index);
+   }
+
    /* try to find space with live-range splits */
    res = get_reg_impl(ctx, reg_file, parallelcopies, info, instr);
 
@@ -2976,6 +2988,24 @@ emit_parallel_copy(ra_ctx& ctx, std::vector<std::pair<Operand, Definition>>& par
                                register_file);
 }
 
+/* Whether the shader is big enough that live-range splitting would make RA dominate compile time.
+ * Raytracing and ubershader compiles can have thousands of blocks. */
+bool
+use_fast_path(Program* program)
+{
+   if (program->ra_fast_path)
+      return true;
+
+   if (program->blocks.size() > 4096)
+      return true;
+
+   size_t num_instructions = 0;
+   for (Block& block : program->blocks)
+      num_instructions += block.instructions.size();
+
+   return num_instructions > 65536;
+}
+
 } /* end namespace */
 
 void
@@ -2983,6 +3013,7 @@ register_allocation(Program* program, live& live_vars, ra_test_policy policy)
 {
    std::vector<IDSet>& live_out_per_block = live_vars.live_out;
    ra_ctx ctx(program, policy);
+   ctx.fast_path = use_fast_path(program);
    get_affinities(ctx, live_out_per_block);
 
    for (Block& block : program->blocks) {
@@ -97,11 +97,16 @@ reindex_program(idx_ctx& ctx, Program* program)
 void
 update_live_out(idx_ctx& ctx, std::vector<IDSet>& live_out)
 {
+   std::vector<uint32_t> ids;
    for (IDSet& set : live_out) {
-      IDSet new_set;
+      ids.clear();
       for (uint32_t id : set)
-         new_set.insert(ctx.renames[id]);
-      set = new_set;
+         ids.push_back(ctx.renames[id]);
+
+      /* Rebuild the set in place to keep it in the live-out arena. */
+      set.clear();
+      for (uint32_t id : ids)
+         set.insert(id);
    }
 }
 
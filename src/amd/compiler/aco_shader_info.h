@@ -196,6 +196,7 @@ enum aco_statistic {
    aco_statistic_vmem,
    aco_statistic_smem,
    aco_statistic_vopd,
+   aco_statistic_ra_fast_path,
    aco_num_statistics
 };
 
@@ -95,11 +95,11 @@ struct spill_ctx {
    std::vector<loop_info> loop;
 
    std::vector<use_info> ssa_infos;
-   std::vector<std::pair<RegClass, std::unordered_set<uint32_t>>> interferences;
+   std::vector<std::pair<RegClass, aco::unordered_set<uint32_t>>> interferences;
    std::vector<std::vector<uint32_t>> affinities;
    std::vector<bool> is_reloaded;
    aco::unordered_map<Temp, remat_info> remat;
-   std::set<Instruction*> unused_remats;
+   aco::unordered_set<Instruction*> unused_remats;
    unsigned wave_size;
 
    unsigned sgpr_spill_slots;
@@ -112,7 +112,8 @@ struct spill_ctx {
          spills_entry(program->blocks.size(), aco::unordered_map<Temp, uint32_t>(memory)),
          spills_exit(program->blocks.size(), aco::unordered_map<Temp, uint32_t>(memory)),
          processed(program->blocks.size(), false), ssa_infos(program->peekAllocationId()),
-         remat(memory), wave_size(program->wave_size), sgpr_spill_slots(0), vgpr_spill_slots(0)
+         remat(memory), unused_remats(memory), wave_size(program->wave_size), sgpr_spill_slots(0),
+         vgpr_spill_slots(0)
    {}
 
    void add_affinity(uint32_t first, uint32_t second)
@@ -171,7 +172,7 @@ struct spill_ctx {
 
    uint32_t allocate_spill_id(RegClass rc)
    {
-      interferences.emplace_back(rc, std::unordered_set<uint32_t>());
+      interferences.emplace_back(rc, aco::unordered_set<uint32_t>(memory));
       is_reloaded.push_back(false);
       return next_spill_id++;
    }
@@ -446,7 +447,7 @@ init_live_in_vars(spill_ctx& ctx, Block* block, unsigned block_idx)
       }
 
       /* create new loop_info */
-      loop_info info = {block_idx, ctx.spills_entry[block_idx], live_in};
+      loop_info info = {block_idx, ctx.spills_entry[block_idx], IDSet(live_in, ctx.memory)};
       ctx.loop.emplace_back(std::move(info));
 
       /* shortcut */
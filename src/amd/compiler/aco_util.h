@@ -38,6 +38,7 @@
 #include <map>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace aco {
@@ -237,6 +238,205 @@ private:
    size_type length{0}; //!> Size of the span
 };
 
+/*
+ * Memory held by the monotonic_buffer_resources of the current thread. Compilations run on a
+ * single thread, so this is used to report the peak arena memory and the number of buffers
+ * malloc()'d per compilation.
+ */
+struct arena_stats {
+   size_t bytes;
+   size_t peak_bytes;
+   uint32_t num_buffers;
+};
+
+inline thread_local arena_stats thread_arena_stats;
+
+/*
+ * Light-weight memory resource which allows to sequentially allocate from
+ * a buffer. The release() method frees all buffers except the newest (and
+ * largest) one, which is reset and reused for subsequent allocations. The
+ * destructor frees all managed memory.
+ *
+ * The memory resource is not thread-safe.
+ * This class mimics std::pmr::monotonic_buffer_resource
+ */
+class monotonic_buffer_resource final {
+public:
+   explicit monotonic_buffer_resource(size_t size = initial_size)
+   {
+      /* The size parameter refers to the total size of the buffer.
+       * The usable data_size is size - sizeof(Buffer).
+       */
+      size = MAX2(size, minimum_size);
+      buffer = create_buffer(size, nullptr);
+   }
+
+   ~monotonic_buffer_resource()
+   {
+      release();
+      destroy_buffer(buffer);
+   }
+
+   /* Delete copy-constructor and -assignment to avoid double free() */
+   monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+   monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+   void* allocate(size_t size, size_t alignment)
+   {
+      buffer->current_idx = align(buffer->current_idx, alignment);
+      if (buffer->current_idx + size <= buffer->data_size) {
+         uint8_t* ptr = &buffer->data[buffer->current_idx];
+         buffer->current_idx += size;
+         return ptr;
+      }
+
+      /* create new larger buffer */
+      uint32_t total_size = buffer->data_size + sizeof(Buffer);
+      do {
+         total_size *= 2;
+      } while (total_size - sizeof(Buffer) < size);
+      buffer = create_buffer(total_size, buffer);
+
+      return allocate(size, alignment);
+   }
+
+   /* Keeps the most recent (and largest) buffer, so that an arena which is released regularly
+    * stops allocating once it has grown to its working set size.
+    */
+   void release()
+   {
+      while (buffer->next) {
+         Buffer* next = buffer->next->next;
+         destroy_buffer(buffer->next);
+         buffer->next = next;
+      }
+      buffer->current_idx = 0;
+   }
+
+   bool operator==(const monotonic_buffer_resource& other) { return buffer == other.buffer; }
+
+private:
+   struct Buffer {
+      Buffer* next;
+      uint32_t current_idx;
+      uint32_t data_size;
+      uint8_t data[];
+   };
+
+   static Buffer* create_buffer(size_t size, Buffer* next)
+   {
+      Buffer* buf = (Buffer*)malloc(size);
+      buf->next = next;
+      buf->data_size = size - sizeof(Buffer);
+      buf->current_idx = 0;
+
+      arena_stats& stats = thread_arena_stats;
+      stats.bytes += size;
+      stats.peak_bytes = MAX2(stats.peak_bytes, stats.bytes);
+      stats.num_buffers++;
+      return buf;
+   }
+
+   static void destroy_buffer(Buffer* buf)
+   {
+      /* The arena might have been created on another thread. */
+      arena_stats& stats = thread_arena_stats;
+      stats.bytes -= MIN2(stats.bytes, buf->data_size + sizeof(Buffer));
+      free(buf);
+   }
+
+   Buffer* buffer;
+   static constexpr size_t initial_size = 4096;
+   static constexpr size_t minimum_size = 128;
+   static_assert(minimum_size > sizeof(Buffer));
+};
+
+/*
+ * Small memory allocator which wraps monotonic_buffer_resource
+ * in order to implement <allocator_traits>.
+ *
+ * This class mimics std::pmr::polymorphic_allocator with monotonic_buffer_resource
+ * as memory resource. The advantage of this specialization is the absence of
+ * virtual function calls and the propagation on swap, copy- and move assignment.
+ */
+template <typename T> class monotonic_allocator {
+public:
+   monotonic_allocator() = delete;
+   monotonic_allocator(monotonic_buffer_resource& m) : memory_resource(m) {}
+   template <typename U>
+   explicit monotonic_allocator(const monotonic_allocator<U>& rhs)
+       : memory_resource(rhs.memory_resource)
+   {}
+
+   /* Memory Allocation */
+   T* allocate(size_t size)
+   {
+      uint32_t bytes = sizeof(T) * size;
+      return (T*)memory_resource.get().allocate(bytes, alignof(T));
+   }
+
+   /* Memory will be freed on destruction of memory_resource */
+   void deallocate(T* ptr, size_t size) {}
+
+   /* Implement <allocator_traits> */
+   using value_type = T;
+   template <class U> struct rebind {
+      using other = monotonic_allocator<U>;
+   };
+
+   typedef std::true_type propagate_on_container_copy_assignment;
+   typedef std::true_type propagate_on_container_move_assignment;
+   typedef std::true_type propagate_on_container_swap;
+
+   template <typename> friend class monotonic_allocator;
+   template <typename X, typename Y>
+   friend bool operator==(monotonic_allocator<X> const& a, monotonic_allocator<Y> const& b);
+   template <typename X, typename Y>
+   friend bool operator!=(monotonic_allocator<X> const& a, monotonic_allocator<Y> const& b);
+
+private:
+   std::reference_wrapper<monotonic_buffer_resource> memory_resource;
+};
+
+/* Necessary for <allocator_traits>. */
+template <typename X, typename Y>
+inline bool
+operator==(monotonic_allocator<X> const& a, monotonic_allocator<Y> const& b)
+{
+   return a.memory_resource.get() == b.memory_resource.get();
+}
+template <typename X, typename Y>
+inline bool
+operator!=(monotonic_allocator<X> const& a, monotonic_allocator<Y> const& b)
+{
+   return !(a == b);
+}
+
+/*
+ * aco::map - alias for std::map with monotonic_allocator
+ *
+ * This template specialization mimics std::pmr::map.
+ */
+template <class Key, class T, class Compare = std::less<Key>>
+using map = std::map<Key, T, Compare, aco::monotonic_allocator<std::pair<const Key, T>>>;
+
+/*
+ * aco::unordered_map - alias for std::unordered_map with monotonic_allocator
+ *
+ * This template specialization mimics std::pmr::unordered_map.
+ */
+template <class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+using unordered_map =
+   std::unordered_map<Key, T, Hash, Pred, aco::monotonic_allocator<std::pair<const Key, T>>>;
+
+/*
+ * aco::unordered_set - alias for std::unordered_set with monotonic_allocator
+ *
+ * This template specialization mimics std::pmr::unordered_set.
+ */
+template <class Key, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+using unordered_set = std::unordered_set<Key, Hash, Pred, aco::monotonic_allocator<Key>>;
+
 /*
  * Cache-friendly set of 32-bit IDs with fast insert/erase/lookup and
  * the ability to efficiently iterate over contained elements.
@@ -245,6 +445,9 @@ private:
  * corresponding bit in the appropriate bit vector is set. It doesn't use std::vector<bool> since
  * we then couldn't efficiently iterate over the elements.
  *
+ * The bit vectors are allocated from a monotonic_buffer_resource, so sets which are rebuilt often
+ * should use an arena that is released regularly.
+ *
  * The interface resembles a subset of std::set/std::unordered_set.
  */
 struct IDSet {
@@ -253,7 +456,7 @@ struct IDSet {
 
    struct Iterator {
       const IDSet* set;
-      std::map<uint32_t, block_t>::const_iterator block;
+      aco::map<uint32_t, block_t>::const_iterator block;
       uint32_t id;
 
       Iterator& operator++();
@@ -263,6 +466,9 @@ struct IDSet {
       uint32_t operator*() const;
    };
 
+   explicit IDSet(monotonic_buffer_resource& m) : words(m) {}
+   IDSet(const IDSet& other, monotonic_buffer_resource& m) : words(other.words, m) {}
+
    size_t count(uint32_t id) const { return find(id) != end(); }
 
    Iterator find(uint32_t id) const
@@ -297,7 +503,7 @@ struct IDSet {
       return std::make_pair(Iterator{this, it, id}, true);
    }
 
-   bool insert(const IDSet other)
+   bool insert(const IDSet& other)
    {
       bool inserted = false;
 
@@ -370,6 +576,8 @@ struct IDSet {
 
    bool empty() const { return !size(); }
 
+   void clear() { words.clear(); }
+
 private:
    static uint32_t get_first_set(const block_t& words)
    {
@@ -380,7 +588,7 @@ private:
       return UINT32_MAX;
    }
 
-   std::map<uint32_t, block_t> words;
+   aco::map<uint32_t, block_t> words;
 };
 
 inline IDSet::Iterator&
@@ -431,165 +639,6 @@ IDSet::Iterator::operator*() const
    return id;
 }
 
-/*
- * Light-weight memory resource which allows to sequentially allocate from
- * a buffer. Both, the release() method and the destructor release all managed
- * memory.
- *
- * The memory resource is not thread-safe.
- * This class mimics std::pmr::monotonic_buffer_resource
- */
-class monotonic_buffer_resource final {
-public:
-   explicit monotonic_buffer_resource(size_t size = initial_size)
-   {
-      /* The size parameter refers to the total size of the buffer.
-       * The usable data_size is size - sizeof(Buffer).
-       */
-      size = MAX2(size, minimum_size);
-      buffer = (Buffer*)malloc(size);
-      buffer->next = nullptr;
-      buffer->data_size = size - sizeof(Buffer);
-      buffer->current_idx = 0;
-   }
-
-   ~monotonic_buffer_resource()
-   {
-      release();
-      free(buffer);
-   }
-
-   /* Delete copy-constructor and -assignment to avoid double free() */
-   monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
-   monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
-
-   void* allocate(size_t size, size_t alignment)
-   {
-      buffer->current_idx = align(buffer->current_idx, alignment);
-      if (buffer->current_idx + size <= buffer->data_size) {
-         uint8_t* ptr = &buffer->data[buffer->current_idx];
-         buffer->current_idx += size;
-         return ptr;
-      }
-
-      /* create new larger buffer */
-      uint32_t total_size = buffer->data_size + sizeof(Buffer);
-      do {
-         total_size *= 2;
-      } while (total_size - sizeof(Buffer) < size);
-      Buffer* next = buffer;
-      buffer = (Buffer*)malloc(total_size);
-      buffer->next = next;
-      buffer->data_size = total_size - sizeof(Buffer);
-      buffer->current_idx = 0;
-
-      return allocate(size, alignment);
-   }
-
-   void release()
-   {
-      while (buffer->next) {
-         Buffer* next = buffer->next;
-         free(buffer);
-         buffer = next;
-      }
-      buffer->current_idx = 0;
-   }
-
-   bool operator==(const monotonic_buffer_resource& other) { return buffer == other.buffer; }
-
-private:
-   struct Buffer {
-      Buffer* next;
-      uint32_t current_idx;
-      uint32_t data_size;
-      uint8_t data[];
-   };
-
-   Buffer* buffer;
-   static constexpr size_t initial_size = 4096;
-   static constexpr size_t minimum_size = 128;
-   static_assert(minimum_size > sizeof(Buffer));
-};
-
-/*
- * Small memory allocator which wraps monotonic_buffer_resource
- * in order to implement <allocator_traits>.
- *
- * This class mimics std::pmr::polymorphic_allocator with monotonic_buffer_resource
- * as memory resource. The advantage of this specialization is the absence of
- * virtual function calls and the propagation on swap, copy- and move assignment.
- */
-template <typename T> class monotonic_allocator {
-public:
-   monotonic_allocator() = delete;
-   monotonic_allocator(monotonic_buffer_resource& m) : memory_resource(m) {}
-   template <typename U>
-   explicit monotonic_allocator(const monotonic_allocator<U>& rhs)
-       : memory_resource(rhs.memory_resource)
-   {}
-
-   /* Memory Allocation */
-   T* allocate(size_t size)
-   {
-      uint32_t bytes = sizeof(T) * size;
-      return (T*)memory_resource.get().allocate(bytes, alignof(T));
-   }
-
-   /* Memory will be freed on destruction of memory_resource */
-   void deallocate(T* ptr, size_t size) {}
-
-   /* Implement <allocator_traits> */
-   using value_type = T;
-   template <class U> struct rebind {
-      using other = monotonic_allocator<U>;
-   };
-
-   typedef std::true_type propagate_on_container_copy_assignment;
-   typedef std::true_type propagate_on_container_move_assignment;
-   typedef std::true_type propagate_on_container_swap;
-
-   template <typename> friend class monotonic_allocator;
-   template <typename X, typename Y>
-   friend bool operator==(monotonic_allocator<X> const& a, monotonic_allocator<Y> const& b);
-   template <typename X, typename Y>
-   friend bool operator!=(monotonic_allocator<X> const& a, monotonic_allocator<Y> const& b);
-
-private:
-   std::reference_wrapper<monotonic_buffer_resource> memory_resource;
-};
-
-/* Necessary for <allocator_traits>. */
-template <typename X, typename Y>
-inline bool
-operator==(monotonic_allocator<X> const& a, monotonic_allocator<Y> const& b)
-{
-   return a.memory_resource.get() == b.memory_resource.get();
-}
-template <typename X, typename Y>
-inline bool
-operator!=(monotonic_allocator<X> const& a, monotonic_allocator<Y> const& b)
-{
-   return !(a == b);
-}
-
-/*
- * aco::map - alias for std::map with monotonic_allocator
- *
- * This template specialization mimics std::pmr::map.
- */
-template <class Key, class T, class Compare = std::less<Key>>
-using map = std::map<Key, T, Compare, aco::monotonic_allocator<std::pair<const Key, T>>>;
-
-/*
- * aco::unordered_map - alias for std::unordered_map with monotonic_allocator
- *
- * This template specialization mimics std::pmr::unordered_map.
- */
-template <class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
-using unordered_map =
-   std::unordered_map<Key, T, Hash, Pred, aco::monotonic_allocator<std::pair<const Key, T>>>;
-
 /*
  * Helper class for a integer/bool (access_type) packed into
  * a bigger integer (data_type) with an offset and size.
@@ -657,3 +657,36 @@ BEGIN_TEST(regalloc.linear_vgpr.compact_for_future_phis)
       finish_ra_test(ra_test_policy());
    }
 END_TEST
+
+BEGIN_TEST(regalloc.fast_path.increase_register_file)
+   if (!setup_cs("", GFX8))
+      return;
+
+   program->ra_fast_path = true;
+   program->collect_statistics = true;
+   std::fill(std::begin(program->statistics), std::end(program->statistics), 0);
+
+   /* Fill the 32 VGPRs available at the maximum number of waves and free every other one, so
+    * there is enough space for a v2 but none of it is contiguous.
+    */
+   Temp tmp[32];
+   for (unsigned i = 0; i < 32; i++)
+      tmp[i] = bld.pseudo(aco_opcode::p_unit_test, bld.def(v1));
+   for (unsigned i = 1; i < 32; i += 2)
+      bld.pseudo(aco_opcode::p_unit_test, tmp[i]);
+
+   /* Instead of splitting live ranges, the fast path grows the register file. */
+   //>> p_unit_test 0
+   //! v2: %vec:v[#_-#_] = p_unit_test
+   bld.pseudo(aco_opcode::p_unit_test, Operand::zero());
+   Temp vec = bld.pseudo(aco_opcode::p_unit_test, bld.def(v2));
+
+   for (unsigned i = 0; i < 32; i += 2)
+      bld.pseudo(aco_opcode::p_unit_test, tmp[i]);
+   bld.pseudo(aco_opcode::p_unit_test, vec);
+
+   finish_ra_test(ra_test_policy());
+
+   //>> ra_fast_path: 1
+   fprintf(output, "ra_fast_path: %u\n", program->statistics[aco_statistic_ra_fast_path]);
+END_TEST
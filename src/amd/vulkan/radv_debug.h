@@ -73,6 +73,7 @@ enum {
    RADV_DEBUG_NO_MESH_SHADER = 1ull << 42,
    RADV_DEBUG_NO_NGG_GS = 1ull << 43,
    RADV_DEBUG_NO_GS_FAST_LAUNCH_2 = 1ull << 44,
+   RADV_DEBUG_NO_COMPILE_THREADS = 1ull << 45,
 };
 
 enum {
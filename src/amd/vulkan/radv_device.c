@@ -69,6 +69,7 @@ typedef void *drmDevicePtr;
 #include "util/mesa-sha1.h"
 #include "util/os_time.h"
 #include "util/timespec.h"
+#include "util/u_cpu_detect.h"
 #include "util/u_atomic.h"
 #include "util/u_process.h"
 #include "vulkan/vk_icd.h"
@@ -715,6 +716,7 @@ radv_CreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo *pCr
    simple_mtx_init(&device->pstate_mtx, mtx_plain);
    simple_mtx_init(&device->rt_handles_mtx, mtx_plain);
    simple_mtx_init(&device->compute_scratch_mtx, mtx_plain);
+   simple_mtx_init(&device->shader_compile_queue_mtx, mtx_plain);
 
    device->rt_handles = _mesa_hash_table_create(NULL, _mesa_hash_u32, _mesa_key_u32_equal);
 
@@ -1093,6 +1095,7 @@ fail_queue:
    simple_mtx_destroy(&device->trace_mtx);
    simple_mtx_destroy(&device->rt_handles_mtx);
    simple_mtx_destroy(&device->compute_scratch_mtx);
+   simple_mtx_destroy(&device->shader_compile_queue_mtx);
    mtx_destroy(&device->overallocation_mutex);
 
    vk_device_finish(&device->vk);
@@ -1138,6 +1141,9 @@ radv_DestroyDevice(VkDevice _device, const VkAllocationCallbacks *pAllocator)
 
    _mesa_hash_table_destroy(device->rt_handles, NULL);
 
+   if (device->has_shader_compile_queue)
+      util_queue_destroy(&device->shader_compile_queue);
+
    radv_device_finish_meta(device);
 
    vk_pipeline_cache_destroy(device->mem_cache, NULL);
@@ -1155,6 +1161,7 @@ radv_DestroyDevice(VkDevice _device, const VkAllocationCallbacks *pAllocator)
    simple_mtx_destroy(&device->trace_mtx);
    simple_mtx_destroy(&device->rt_handles_mtx);
    simple_mtx_destroy(&device->compute_scratch_mtx);
+   simple_mtx_destroy(&device->shader_compile_queue_mtx);
 
    radv_trap_handler_finish(device);
    radv_finish_trace(device);
@@ -2076,3 +2083,32 @@ radv_GetDeviceImageSubresourceLayoutKHR(VkDevice device, const VkDeviceImageSubr
 
    radv_DestroyImage(device, image, NULL);
 }
+
+/* Returns the thread pool used to compile independent shaders of a pipeline
+ * concurrently, or NULL if shaders have to be compiled on the calling thread.
+ *
+ * The pool is sized to the number of CPUs, but util_queue starts with a single
+ * thread and only adds threads while jobs are waiting, so a device that never
+ * compiles more than one shader at a time keeps a single compile thread.
+ */
+struct util_queue *
+radv_device_get_shader_compile_queue(struct radv_device *device)
+{
+   const struct radv_physical_device *pdev = radv_device_physical(device);
+   const struct radv_instance *instance = radv_physical_device_instance(pdev);
+
+   simple_mtx_lock(&device->shader_compile_queue_mtx);
+   if (!device->shader_compile_queue_initialized) {
+      const unsigned num_threads = util_get_cpu_caps()->nr_cpus;
+
+      if (num_threads > 1 && !(instance->debug_flags & RADV_DEBUG_NO_COMPILE_THREADS)) {
+         device->has_shader_compile_queue = util_queue_init(&device->shader_compile_queue, "radv_sh", 64, num_threads,
+                                                            UTIL_QUEUE_INIT_RESIZE_IF_FULL, NULL);
+      }
+
+      device->shader_compile_queue_initialized = true;
+   }
+   simple_mtx_unlock(&device->shader_compile_queue_mtx);
+
+   return device->has_shader_compile_queue ? &device->shader_compile_queue : NULL;
+}
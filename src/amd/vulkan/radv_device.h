@@ -32,6 +32,7 @@
 #include "ac_sqtt.h"
 
 #include "util/mesa-blake3.h"
+#include "util/u_queue.h"
 
 #include "radv_queue.h"
 #include "radv_radeon_winsys.h"
@@ -572,6 +573,12 @@ struct radv_device {
    simple_mtx_t compute_scratch_mtx;
    uint32_t compute_scratch_size_per_wave;
    uint32_t compute_scratch_waves;
+
+   /* Threads for compiling independent shaders of a pipeline, created on first use. */
+   simple_mtx_t shader_compile_queue_mtx;
+   struct util_queue shader_compile_queue;
+   bool shader_compile_queue_initialized;
+   bool has_shader_compile_queue;
 };
 
 VK_DEFINE_HANDLE_CASTS(radv_device, vk.base, VkDevice, VK_OBJECT_TYPE_DEVICE)
@@ -669,4 +676,6 @@ bool radv_device_acquire_performance_counters(struct radv_device *device);
 
 void radv_device_release_performance_counters(struct radv_device *device);
 
+struct util_queue *radv_device_get_shader_compile_queue(struct radv_device *device);
+
 #endif /* RADV_DEVICE_H */
@@ -79,6 +79,7 @@ static const struct debug_control radv_debug_options[] = {{"nofastclears", RADV_
                                                           {"nomeshshader", RADV_DEBUG_NO_MESH_SHADER},
                                                           {"nongg_gs", RADV_DEBUG_NO_NGG_GS},
                                                           {"nogsfastlaunch2", RADV_DEBUG_NO_GS_FAST_LAUNCH_2},
+                                                          {"nocompilethreads", RADV_DEBUG_NO_COMPILE_THREADS},
                                                           {NULL, 0}};
 
 const char *
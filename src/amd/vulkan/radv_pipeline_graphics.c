@@ -1991,6 +1991,10 @@ radv_generate_graphics_pipeline_key(const struct radv_device *device, const stru
 
       if (s == MESA_SHADER_MESH && (pipeline->active_stages & VK_SHADER_STAGE_TASK_BIT_EXT))
          key.stage_info[s].has_task_shader = true;
+
+      if ((pipeline->base.create_flags & VK_PIPELINE_CREATE_2_LIBRARY_BIT_KHR) &&
+          (pipeline->base.create_flags & VK_PIPELINE_CREATE_2_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT))
+         key.stage_info[s].fast_compile = true;
    }
 
    return key;
@@ -2349,6 +2353,7 @@ radv_pipeline_retain_shaders(struct radv_retained_shaders *retained_shaders, str
 
       memcpy(retained_shaders->stages[s].shader_sha1, stages[s].shader_sha1, sizeof(stages[s].shader_sha1));
       memcpy(&retained_shaders->stages[s].key, &stages[s].key, sizeof(stages[s].key));
+      retained_shaders->stages[s].key.fast_compile = false;
 
       stages[s].feedback.duration += os_time_get_nano() - stage_start;
    }
@@ -2538,6 +2543,15 @@ radv_graphics_shaders_compile(struct radv_device *device, struct vk_pipeline_cac
       radv_pipeline_retain_shaders(retained_shaders, stages);
    }
 
+   /* The NIR retained for link-time optimization is fully optimized, but the library binaries are
+    * only used for fast-linked pipelines until the optimized pipeline is ready. Compile them with
+    * a single NIR optimization loop and without the ACO optimizer and schedulers to reduce stutter.
+    */
+   for (unsigned s = 0; s < MESA_VULKAN_SHADER_STAGES; s++) {
+      if (stages[s].entrypoint && stages[s].key.fast_compile)
+         stages[s].key.optimisations_disabled = true;
+   }
+
    VkShaderStageFlagBits active_nir_stages = 0;
    for (int i = 0; i < MESA_VULKAN_SHADER_STAGES; i++) {
       if (stages[i].nir)
@@ -2770,6 +2784,7 @@ radv_graphics_pipeline_compile(struct radv_graphics_pipeline *pipeline, const Vk
          for (unsigned i = 0; i < pCreateInfo->stageCount; i++) {
             gl_shader_stage s = vk_to_mesa_shader_stage(pCreateInfo->pStages[i].stage);
             gfx_pipeline_lib->stage_keys[s] = pipeline_key->stage_info[s];
+            gfx_pipeline_lib->stage_keys[s].fast_compile = false;
          }
       }
 
@@ -566,6 +566,57 @@ radv_ray_tracing_stage_is_always_inlined(struct radv_ray_tracing_stage *stage)
    return stage->stage == MESA_SHADER_ANY_HIT || stage->stage == MESA_SHADER_INTERSECTION;
 }
 
+struct radv_rt_compile_job {
+   struct radv_device *device;
+   struct vk_pipeline_cache *cache;
+   const VkRayTracingPipelineCreateInfoKHR *pCreateInfo;
+   struct radv_ray_tracing_pipeline *pipeline;
+   struct radv_shader_stage *stage;
+   struct radv_ray_tracing_stage *rt_stage;
+   struct radv_serialized_shader_arena_block *replay_block;
+   bool monolithic;
+
+   struct util_queue_fence fence;
+   uint32_t stack_size;
+   int64_t duration;
+   VkResult result;
+};
+
+static void
+radv_rt_compile_job_execute(void *data, void *gdata, int thread_index)
+{
+   struct radv_rt_compile_job *job = data;
+   int64_t start = os_time_get_nano();
+
+   job->result = radv_rt_nir_to_asm(job->device, job->cache, job->pCreateInfo, job->pipeline, job->monolithic,
+                                    job->stage, &job->stack_size, &job->rt_stage->info, NULL, job->replay_block,
+                                    &job->rt_stage->shader);
+
+   job->duration = os_time_get_nano() - start;
+}
+
+static bool
+radv_rt_can_compile_in_parallel(const struct radv_device *device, const struct radv_ray_tracing_pipeline *pipeline,
+                                bool monolithic)
+{
+   const struct radv_physical_device *pdev = radv_device_physical(device);
+   const struct radv_instance *instance = radv_physical_device_instance(pdev);
+
+   /* Monolithic raygen shaders inline the traversal, which updates the any-hit stack sizes of the pipeline. */
+   if (monolithic)
+      return false;
+
+   /* Shaders of capture/replay pipelines are placed at fixed addresses. */
+   if (pipeline->base.base.create_flags & VK_PIPELINE_CREATE_2_RAY_TRACING_SHADER_GROUP_HANDLE_CAPTURE_REPLAY_BIT_KHR)
+      return false;
+
+   /* Keep shader dumps in stage order. */
+   if (instance->debug_flags & (RADV_DEBUG_DUMP_SHADERS | RADV_DEBUG_DUMP_SHADER_STATS))
+      return false;
+
+   return true;
+}
+
 static VkResult
 radv_rt_compile_shaders(struct radv_device *device, struct vk_pipeline_cache *cache,
                         const VkRayTracingPipelineCreateInfoKHR *pCreateInfo,
@@ -647,6 +698,13 @@ radv_rt_compile_shaders(struct radv_device *device, struct vk_pipeline_cache *ca
       stage->feedback.duration += os_time_get_nano() - stage_start;
    }
 
+   struct radv_rt_compile_job *jobs = calloc(pCreateInfo->stageCount, sizeof(*jobs));
+   if (!jobs) {
+      result = VK_ERROR_OUT_OF_HOST_MEMORY;
+      goto cleanup;
+   }
+
+   unsigned num_jobs = 0;
    for (uint32_t idx = 0; idx < pCreateInfo->stageCount; idx++) {
       int64_t stage_start = os_time_get_nano();
       struct radv_shader_stage *stage = &stages[idx];
@@ -661,28 +719,78 @@ radv_rt_compile_shaders(struct radv_device *device, struct vk_pipeline_cache *ca
          shader_needed &= !monolithic || raygen_imported;
 
       if (shader_needed) {
-         uint32_t stack_size = 0;
-         struct radv_serialized_shader_arena_block *replay_block =
-            capture_replay_handles[idx].arena_va ? &capture_replay_handles[idx] : NULL;
+         jobs[idx] = (struct radv_rt_compile_job){
+            .device = device,
+            .cache = cache,
+            .pCreateInfo = pCreateInfo,
+            .pipeline = pipeline,
+            .stage = stage,
+            .rt_stage = &rt_stages[idx],
+            .replay_block = capture_replay_handles[idx].arena_va ? &capture_replay_handles[idx] : NULL,
+            .monolithic = monolithic && stage->stage == MESA_SHADER_RAYGEN,
+         };
+         num_jobs++;
+      }
+
+      stage->feedback.duration += os_time_get_nano() - stage_start;
+   }
+
+   /* Separately compiled shaders don't depend on each other, so compile them concurrently. The results only
+    * depend on the stage index and errors are reported in stage order, so the pipeline is the same as with
+    * sequential compilation.
+    */
+   struct util_queue *queue = NULL;
+   if (num_jobs > 1 && radv_rt_can_compile_in_parallel(device, pipeline, monolithic))
+      queue = radv_device_get_shader_compile_queue(device);
 
-         bool monolithic_raygen = monolithic && stage->stage == MESA_SHADER_RAYGEN;
+   for (uint32_t idx = 0; idx < pCreateInfo->stageCount; idx++) {
+      if (!jobs[idx].stage)
+         continue;
 
-         result = radv_rt_nir_to_asm(device, cache, pCreateInfo, pipeline, monolithic_raygen, stage, &stack_size,
-                                     &rt_stages[idx].info, NULL, replay_block, &rt_stages[idx].shader);
-         if (result != VK_SUCCESS)
-            goto cleanup;
+      if (queue) {
+         util_queue_fence_init(&jobs[idx].fence);
+         util_queue_add_job(queue, &jobs[idx], &jobs[idx].fence, radv_rt_compile_job_execute, NULL, 0);
+      } else {
+         radv_rt_compile_job_execute(&jobs[idx], NULL, 0);
 
-         assert(rt_stages[idx].stack_size <= stack_size);
-         rt_stages[idx].stack_size = stack_size;
+         /* Stop at the first error like before. */
+         if (jobs[idx].result != VK_SUCCESS)
+            break;
+      }
+   }
+
+   for (uint32_t idx = 0; idx < pCreateInfo->stageCount; idx++) {
+      struct radv_rt_compile_job *job = &jobs[idx];
+      struct radv_shader_stage *stage = &stages[idx];
+
+      if (job->stage) {
+         if (queue) {
+            util_queue_fence_wait(&job->fence);
+            util_queue_fence_destroy(&job->fence);
+         }
+
+         if (result == VK_SUCCESS && job->result != VK_SUCCESS)
+            result = job->result;
+
+         if (job->result == VK_SUCCESS && job->rt_stage->shader) {
+            assert(rt_stages[idx].stack_size <= job->stack_size);
+            rt_stages[idx].stack_size = job->stack_size;
+         }
+
+         stage->feedback.duration += job->duration;
       }
 
       if (creation_feedback && creation_feedback->pipelineStageCreationFeedbackCount) {
          assert(idx < creation_feedback->pipelineStageCreationFeedbackCount);
-         stage->feedback.duration += os_time_get_nano() - stage_start;
          creation_feedback->pPipelineStageCreationFeedbacks[idx] = stage->feedback;
       }
    }
 
+   free(jobs);
+
+   if (result != VK_SUCCESS)
+      goto cleanup;
+
    /* Monolithic raygen shaders do not need a traversal shader. Skip compiling one if there are only monolithic raygen
     * shaders.
     */
@@ -102,6 +102,11 @@ struct radv_shader_stage_key {
 
    /* Whether the mesh shader is used with a task shader. */
    uint8_t has_task_shader : 1;
+
+   /* Whether the shader is part of a library that retains its NIR for link-time optimization, in
+    * which case the library binary only matters until the app links the optimized pipeline.
+    */
+   uint8_t fast_compile : 1;
 };
 
 struct radv_ps_epilog_key {
@@ -0,0 +1,800 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Compiles a corpus of SPIR-V compute shaders with RADV on top of the null
+ * winsys, so no GPU is needed, and prints one JSON object per compiled
+ * pipeline followed by a summary object.
+ *
+ * Pipeline layouts are derived from the descriptor decorations in each
+ * module.  Every pipeline is created with creation feedback and statistics
+ * capture enabled, so the output contains the driver-reported compile time,
+ * whether the pipeline cache was hit and the ACO statistics of the resulting
+ * executable.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "c11/threads.h"
+#include "compiler/spirv/spirv.h"
+#include "util/macros.h"
+#include "util/os_file.h"
+#include "util/os_time.h"
+#include "util/u_atomic.h"
+#include "util/u_dynarray.h"
+#include "util/u_thread.h"
+#include "vulkan/vulkan_core.h"
+
+PFN_vkVoidFunction VKAPI_CALL vk_icdGetInstanceProcAddr(VkInstance instance, const char *pName);
+
+#define FUNCTION_LIST                                                                                                  \
+   ITEM(CreateComputePipelines)                                                                                        \
+   ITEM(CreateDescriptorSetLayout)                                                                                     \
+   ITEM(CreateDevice)                                                                                                  \
+   ITEM(CreatePipelineCache)                                                                                           \
+   ITEM(CreatePipelineLayout)                                                                                          \
+   ITEM(CreateShaderModule)                                                                                            \
+   ITEM(DestroyDescriptorSetLayout)                                                                                    \
+   ITEM(DestroyDevice)                                                                                                 \
+   ITEM(DestroyInstance)                                                                                               \
+   ITEM(DestroyPipeline)                                                                                               \
+   ITEM(DestroyPipelineCache)                                                                                          \
+   ITEM(DestroyPipelineLayout)                                                                                         \
+   ITEM(DestroyShaderModule)                                                                                           \
+   ITEM(EnumeratePhysicalDevices)                                                                                      \
+   ITEM(GetPhysicalDeviceFeatures2)                                                                                    \
+   ITEM(GetPipelineExecutablePropertiesKHR)                                                                            \
+   ITEM(GetPipelineExecutableStatisticsKHR)
+
+#define ITEM(n) static PFN_vk##n n;
+FUNCTION_LIST
+#undef ITEM
+
+#define MAX_SETS           32
+#define RUNTIME_ARRAY_SIZE 64
+
+struct bench_shader {
+   const char *filename;
+   const char *error;
+
+   char *entrypoint;
+   VkShaderModule module;
+   VkDescriptorSetLayout set_layouts[MAX_SETS];
+   VkPipelineLayout layout;
+};
+
+struct bench {
+   VkInstance instance;
+   VkDevice device;
+   VkPipelineCache cache;
+
+   struct bench_shader *shaders;
+   unsigned num_shaders;
+   unsigned iterations;
+
+   unsigned next_job;
+   unsigned failed;
+   unsigned cache_hits;
+   uint64_t pipeline_ns;
+
+   FILE *out;
+   mtx_t out_lock;
+};
+
+/* Minimal SPIR-V reflection: just enough to build a compatible pipeline
+ * layout and to find the compute entrypoint.
+ */
+struct spirv_id {
+   SpvOp op;
+   const uint32_t *words;
+
+   bool has_set, has_binding, block, buffer_block;
+   uint32_t set, binding;
+};
+
+static VkDescriptorType
+spirv_descriptor_type(const struct spirv_id *ids, uint32_t bound, uint32_t type, SpvStorageClass storage_class,
+                      uint32_t *count)
+{
+   *count = 1;
+
+   while (type < bound) {
+      const struct spirv_id *id = &ids[type];
+
+      switch (id->op) {
+      case SpvOpTypeArray: {
+         const uint32_t length = id->words[3];
+         if (length < bound && ids[length].op == SpvOpConstant)
+            *count *= ids[length].words[3];
+         type = id->words[2];
+         break;
+      }
+      case SpvOpTypeRuntimeArray:
+         *count *= RUNTIME_ARRAY_SIZE;
+         type = id->words[2];
+         break;
+      case SpvOpTypeSampler:
+         return VK_DESCRIPTOR_TYPE_SAMPLER;
+      case SpvOpTypeSampledImage:
+         return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+      case SpvOpTypeImage:
+         if (id->words[3] == SpvDimBuffer)
+            return id->words[7] == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+         if (id->words[3] == SpvDimSubpassData)
+            return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+         return id->words[7] == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+      case SpvOpTypeAccelerationStructureKHR:
+         return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+      case SpvOpTypeStruct:
+         if (storage_class == SpvStorageClassStorageBuffer || id->buffer_block)
+            return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+         return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+      default:
+         return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+      }
+   }
+
+   return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+}
+
+static const char *
+bench_shader_init(struct bench *bench, struct bench_shader *shader, const uint32_t *words, size_t num_words)
+{
+   if (num_words < 5 || words[0] != SpvMagicNumber)
+      return "not a SPIR-V module";
+
+   const uint32_t bound = words[3];
+   struct spirv_id *ids = calloc(bound, sizeof(*ids));
+   if (!ids)
+      return "out of memory";
+
+   bool has_push_constants = false;
+
+   for (size_t w = 5; w < num_words;) {
+      const uint32_t *inst = &words[w];
+      const unsigned count = inst[0] >> SpvWordCountShift;
+      const SpvOp op = inst[0] & SpvOpCodeMask;
+
+      if (count == 0 || w + count > num_words) {
+         free(ids);
+         return "truncated SPIR-V module";
+      }
+      w += count;
+
+      switch (op) {
+      case SpvOpEntryPoint:
+         if (inst[1] == SpvExecutionModelGLCompute && !shader->entrypoint)
+            shader->entrypoint = strndup((const char *)&inst[3], (count - 3) * 4);
+         break;
+      case SpvOpDecorate: {
+         if (inst[1] >= bound)
+            break;
+         struct spirv_id *id = &ids[inst[1]];
+         if (inst[2] == SpvDecorationDescriptorSet) {
+            id->has_set = true;
+            id->set = inst[3];
+         } else if (inst[2] == SpvDecorationBinding) {
+            id->has_binding = true;
+            id->binding = inst[3];
+         } else if (inst[2] == SpvDecorationBlock) {
+            id->block = true;
+         } else if (inst[2] == SpvDecorationBufferBlock) {
+            id->buffer_block = true;
+         }
+         break;
+      }
+      case SpvOpTypeSampler:
+      case SpvOpTypeAccelerationStructureKHR:
+      case SpvOpTypeRuntimeArray:
+      case SpvOpTypeArray:
+      case SpvOpTypeSampledImage:
+      case SpvOpTypeImage:
+      case SpvOpTypeStruct:
+      case SpvOpTypePointer:
+         if (inst[1] < bound) {
+            ids[inst[1]].op = op;
+            ids[inst[1]].words = inst;
+         }
+         break;
+      case SpvOpConstant:
+      case SpvOpVariable:
+         if (inst[2] < bound) {
+            ids[inst[2]].op = op;
+            ids[inst[2]].words = inst;
+         }
+         break;
+      default:
+         break;
+      }
+   }
+
+   if (!shader->entrypoint) {
+      free(ids);
+      return "no GLCompute entrypoint";
+   }
+
+   struct util_dynarray bindings[MAX_SETS];
+   for (unsigned s = 0; s < MAX_SETS; s++)
+      util_dynarray_init(&bindings[s], NULL);
+
+   const char *error = NULL;
+   for (uint32_t i = 0; i < bound; i++) {
+      const struct spirv_id *var = &ids[i];
+      if (var->op != SpvOpVariable)
+         continue;
+
+      const SpvStorageClass storage_class = var->words[3];
+      if (storage_class == SpvStorageClassPushConstant) {
+         has_push_constants = true;
+         continue;
+      }
+
+      if (!var->has_set || !var->has_binding)
+         continue;
+
+      if (var->set >= MAX_SETS) {
+         error = "descriptor set index too large";
+         break;
+      }
+
+      const uint32_t ptr_type = var->words[1];
+      if (ptr_type >= bound || ids[ptr_type].op != SpvOpTypePointer)
+         continue;
+
+      uint32_t count;
+      VkDescriptorType type = spirv_descriptor_type(ids, bound, ids[ptr_type].words[3], storage_class, &count);
+      if (type == VK_DESCRIPTOR_TYPE_MAX_ENUM)
+         continue;
+
+      bool aliased = false;
+      util_dynarray_foreach (&bindings[var->set], VkDescriptorSetLayoutBinding, b)
+         aliased |= b->binding == var->binding;
+      if (aliased)
+         continue;
+
+      VkDescriptorSetLayoutBinding binding = {
+         .binding = var->binding,
+         .descriptorType = type,
+         .descriptorCount = count,
+         .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+      };
+      util_dynarray_append(&bindings[var->set], VkDescriptorSetLayoutBinding, binding);
+   }
+
+   free(ids);
+
+   unsigned num_sets = 0;
+   for (unsigned s = 0; s < MAX_SETS && !error; s++) {
+      const VkDescriptorSetLayoutCreateInfo set_info = {
+         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+         .bindingCount = util_dynarray_num_elements(&bindings[s], VkDescriptorSetLayoutBinding),
+         .pBindings = util_dynarray_begin(&bindings[s]),
+      };
+      if (CreateDescriptorSetLayout(bench->device, &set_info, NULL, &shader->set_layouts[s]) != VK_SUCCESS)
+         error = "failed to create a descriptor set layout";
+      else if (set_info.bindingCount)
+         num_sets = s + 1;
+   }
+
+   for (unsigned s = 0; s < MAX_SETS; s++)
+      util_dynarray_fini(&bindings[s]);
+
+   if (error)
+      return error;
+
+   const VkPushConstantRange push_range = {
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+      .offset = 0,
+      .size = 256,
+   };
+   const VkPipelineLayoutCreateInfo layout_info = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+      .setLayoutCount = num_sets,
+      .pSetLayouts = shader->set_layouts,
+      .pushConstantRangeCount = has_push_constants ? 1 : 0,
+      .pPushConstantRanges = &push_range,
+   };
+   if (CreatePipelineLayout(bench->device, &layout_info, NULL, &shader->layout) != VK_SUCCESS)
+      return "failed to create the pipeline layout";
+
+   const VkShaderModuleCreateInfo module_info = {
+      .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+      .codeSize = num_words * 4,
+      .pCode = words,
+   };
+   if (CreateShaderModule(bench->device, &module_info, NULL, &shader->module) != VK_SUCCESS)
+      return "failed to create the shader module";
+
+   return NULL;
+}
+
+static void
+bench_shader_finish(struct bench *bench, struct bench_shader *shader)
+{
+   DestroyShaderModule(bench->device, shader->module, NULL);
+   DestroyPipelineLayout(bench->device, shader->layout, NULL);
+   for (unsigned s = 0; s < MAX_SETS; s++)
+      DestroyDescriptorSetLayout(bench->device, shader->set_layouts[s], NULL);
+   free(shader->entrypoint);
+}
+
+static void
+print_json_string(FILE *out, const char *str)
+{
+   fputc('"', out);
+   for (; *str; str++) {
+      if (*str == '"' || *str == '\\')
+         fprintf(out, "\\%c", *str);
+      else if ((unsigned char)*str < 0x20)
+         fprintf(out, "\\u%04x", *str);
+      else
+         fputc(*str, out);
+   }
+   fputc('"', out);
+}
+
+static void
+print_statistics(struct bench *bench, VkPipeline pipeline)
+{
+   FILE *out = bench->out;
+   VkPipelineExecutablePropertiesKHR executables[8];
+   uint32_t num_executables = ARRAY_SIZE(executables);
+
+   for (unsigned i = 0; i < num_executables; i++) {
+      executables[i] = (VkPipelineExecutablePropertiesKHR){
+         .sType = VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_PROPERTIES_KHR,
+      };
+   }
+
+   const VkPipelineInfoKHR pipeline_info = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_INFO_KHR,
+      .pipeline = pipeline,
+   };
+   if (GetPipelineExecutablePropertiesKHR(bench->device, &pipeline_info, &num_executables, executables) < 0)
+      num_executables = 0;
+
+   fprintf(out, ", \"executables\": [");
+   for (uint32_t e = 0; e < num_executables; e++) {
+      VkPipelineExecutableStatisticKHR stats[64];
+      uint32_t num_stats = ARRAY_SIZE(stats);
+
+      for (unsigned i = 0; i < num_stats; i++) {
+         stats[i] = (VkPipelineExecutableStatisticKHR){
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_STATISTIC_KHR,
+         };
+      }
+
+      const VkPipelineExecutableInfoKHR exec_info = {
+         .sType = VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_INFO_KHR,
+         .pipeline = pipeline,
+         .executableIndex = e,
+      };
+      if (GetPipelineExecutableStatisticsKHR(bench->device, &exec_info, &num_stats, stats) < 0)
+         num_stats = 0;
+
+      fprintf(out, "%s{\"name\": ", e ? ", " : "");
+      print_json_string(out, executables[e].name);
+      fprintf(out, ", \"subgroup_size\": %u, \"statistics\": {", executables[e].subgroupSize);
+
+      for (uint32_t s = 0; s < num_stats; s++) {
+         fprintf(out, "%s", s ? ", " : "");
+         print_json_string(out, stats[s].name);
+
+         switch (stats[s].format) {
+         case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_BOOL32_KHR:
+            fprintf(out, ": %s", stats[s].value.b32 ? "true" : "false");
+            break;
+         case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_INT64_KHR:
+            fprintf(out, ": %" PRId64, stats[s].value.i64);
+            break;
+         case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_UINT64_KHR:
+            fprintf(out, ": %" PRIu64, stats[s].value.u64);
+            break;
+         case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_FLOAT64_KHR:
+            fprintf(out, ": %f", stats[s].value.f64);
+            break;
+         default:
+            fprintf(out, ": null");
+            break;
+         }
+      }
+      fprintf(out, "}}");
+   }
+   fprintf(out, "]");
+}
+
+static void
+bench_compile(struct bench *bench, unsigned job, unsigned thread)
+{
+   struct bench_shader *shader = &bench->shaders[job % bench->num_shaders];
+   const unsigned iteration = job / bench->num_shaders;
+
+   if (shader->error) {
+      /* Only report broken inputs once. */
+      if (iteration == 0) {
+         mtx_lock(&bench->out_lock);
+         fprintf(bench->out, "{\"file\": ");
+         print_json_string(bench->out, shader->filename);
+         fprintf(bench->out, ", \"result\": \"skipped\", \"error\": ");
+         print_json_string(bench->out, shader->error);
+         fprintf(bench->out, "}\n");
+         mtx_unlock(&bench->out_lock);
+      }
+      return;
+   }
+
+   VkPipelineCreationFeedback stage_feedback = {0};
+   VkPipelineCreationFeedback feedback = {0};
+   const VkPipelineCreationFeedbackCreateInfo feedback_info = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+      .pPipelineCreationFeedback = &feedback,
+      .pipelineStageCreationFeedbackCount = 1,
+      .pPipelineStageCreationFeedbacks = &stage_feedback,
+   };
+   const VkComputePipelineCreateInfo pipeline_info = {
+      .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .pNext = &feedback_info,
+      .flags = VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR,
+      .stage =
+         {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+            .module = shader->module,
+            .pName = shader->entrypoint,
+         },
+      .layout = shader->layout,
+   };
+
+   VkPipeline pipeline = VK_NULL_HANDLE;
+   const int64_t start = os_time_get_nano();
+   VkResult result = CreateComputePipelines(bench->device, bench->cache, 1, &pipeline_info, NULL, &pipeline);
+   const int64_t wall_ns = os_time_get_nano() - start;
+
+   const bool cache_hit = feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT;
+
+   if (result != VK_SUCCESS) {
+      p_atomic_inc(&bench->failed);
+   } else {
+      p_atomic_add(&bench->pipeline_ns, feedback.duration);
+      if (cache_hit)
+         p_atomic_inc(&bench->cache_hits);
+   }
+
+   mtx_lock(&bench->out_lock);
+   fprintf(bench->out, "{\"file\": ");
+   print_json_string(bench->out, shader->filename);
+   fprintf(bench->out, ", \"iteration\": %u, \"thread\": %u", iteration, thread);
+   if (result != VK_SUCCESS) {
+      fprintf(bench->out, ", \"result\": \"failed\", \"vk_result\": %d, \"wall_ns\": %" PRId64 "}\n", result,
+              wall_ns);
+   } else {
+      fprintf(bench->out,
+              ", \"result\": \"ok\", \"wall_ns\": %" PRId64 ", \"pipeline_ns\": %" PRIu64 ", \"stage_ns\": %" PRIu64
+              ", \"cache_hit\": %s",
+              wall_ns, feedback.duration, stage_feedback.duration, cache_hit ? "true" : "false");
+      print_statistics(bench, pipeline);
+      fprintf(bench->out, "}\n");
+   }
+   mtx_unlock(&bench->out_lock);
+
+   DestroyPipeline(bench->device, pipeline, NULL);
+}
+
+struct bench_thread {
+   struct bench *bench;
+   unsigned index;
+   thrd_t thread;
+};
+
+static int
+bench_thread_main(void *data)
+{
+   struct bench_thread *thread = data;
+   struct bench *bench = thread->bench;
+   const unsigned num_jobs = bench->num_shaders * bench->iterations;
+
+   while (true) {
+      const unsigned job = p_atomic_inc_return(&bench->next_job) - 1;
+      if (job >= num_jobs)
+         break;
+
+      bench_compile(bench, job, thread->index);
+   }
+
+   return 0;
+}
+
+static bool
+bench_create_device(struct bench *bench, const char *family)
+{
+   setenv("RADV_FORCE_FAMILY", family, 1);
+
+   const VkApplicationInfo app_info = {
+      .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+      .pApplicationName = "radv_compile_bench",
+      .apiVersion = VK_API_VERSION_1_3,
+   };
+   const VkInstanceCreateInfo instance_info = {
+      .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+      .pApplicationInfo = &app_info,
+   };
+   PFN_vkCreateInstance CreateInstance = (PFN_vkCreateInstance)vk_icdGetInstanceProcAddr(NULL, "vkCreateInstance");
+   if (CreateInstance(&instance_info, NULL, &bench->instance) != VK_SUCCESS)
+      return false;
+
+#define ITEM(n) n = (PFN_vk##n)vk_icdGetInstanceProcAddr(bench->instance, "vk" #n);
+   FUNCTION_LIST
+#undef ITEM
+
+   uint32_t count = 1;
+   VkPhysicalDevice pdev = VK_NULL_HANDLE;
+   if (EnumeratePhysicalDevices(bench->instance, &count, &pdev) < 0 || pdev == VK_NULL_HANDLE)
+      return false;
+
+   VkPhysicalDeviceVulkan13Features supported13 = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES,
+   };
+   VkPhysicalDeviceVulkan12Features supported12 = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+      .pNext = &supported13,
+   };
+   VkPhysicalDeviceVulkan11Features supported11 = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES,
+      .pNext = &supported12,
+   };
+   VkPhysicalDeviceFeatures2 supported = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+      .pNext = &supported11,
+   };
+   GetPhysicalDeviceFeatures2(pdev, &supported);
+
+   /* Only enable the features that compute shaders can depend on.  Features
+    * like robustBufferAccess change the generated code, so the results
+    * wouldn't match what most applications get.
+    */
+   VkPhysicalDeviceVulkan13Features features13 = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES,
+      .subgroupSizeControl = supported13.subgroupSizeControl,
+      .computeFullSubgroups = supported13.computeFullSubgroups,
+      .shaderIntegerDotProduct = supported13.shaderIntegerDotProduct,
+      .shaderZeroInitializeWorkgroupMemory = supported13.shaderZeroInitializeWorkgroupMemory,
+      .maintenance4 = supported13.maintenance4,
+   };
+   VkPhysicalDeviceVulkan12Features features12 = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+      .pNext = &features13,
+      .storageBuffer8BitAccess = supported12.storageBuffer8BitAccess,
+      .uniformAndStorageBuffer8BitAccess = supported12.uniformAndStorageBuffer8BitAccess,
+      .storagePushConstant8 = supported12.storagePushConstant8,
+      .shaderBufferInt64Atomics = supported12.shaderBufferInt64Atomics,
+      .shaderSharedInt64Atomics = supported12.shaderSharedInt64Atomics,
+      .shaderFloat16 = supported12.shaderFloat16,
+      .shaderInt8 = supported12.shaderInt8,
+      .shaderUniformBufferArrayNonUniformIndexing = supported12.shaderUniformBufferArrayNonUniformIndexing,
+      .shaderSampledImageArrayNonUniformIndexing = supported12.shaderSampledImageArrayNonUniformIndexing,
+      .shaderStorageBufferArrayNonUniformIndexing = supported12.shaderStorageBufferArrayNonUniformIndexing,
+      .shaderStorageImageArrayNonUniformIndexing = supported12.shaderStorageImageArrayNonUniformIndexing,
+      .runtimeDescriptorArray = supported12.runtimeDescriptorArray,
+      .scalarBlockLayout = supported12.scalarBlockLayout,
+      .uniformBufferStandardLayout = supported12.uniformBufferStandardLayout,
+      .shaderSubgroupExtendedTypes = supported12.shaderSubgroupExtendedTypes,
+      .bufferDeviceAddress = supported12.bufferDeviceAddress,
+      .vulkanMemoryModel = supported12.vulkanMemoryModel,
+      .vulkanMemoryModelDeviceScope = supported12.vulkanMemoryModelDeviceScope,
+   };
+   VkPhysicalDeviceVulkan11Features features11 = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES,
+      .pNext = &features12,
+      .storageBuffer16BitAccess = supported11.storageBuffer16BitAccess,
+      .uniformAndStorageBuffer16BitAccess = supported11.uniformAndStorageBuffer16BitAccess,
+      .storagePushConstant16 = supported11.storagePushConstant16,
+      .variablePointersStorageBuffer = supported11.variablePointersStorageBuffer,
+      .variablePointers = supported11.variablePointers,
+   };
+   VkPhysicalDeviceFeatures2 features = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+      .pNext = &features11,
+      .features = {
+         .shaderImageGatherExtended = supported.features.shaderImageGatherExtended,
+         .shaderStorageImageExtendedFormats = supported.features.shaderStorageImageExtendedFormats,
+         .shaderStorageImageReadWithoutFormat = supported.features.shaderStorageImageReadWithoutFormat,
+         .shaderStorageImageWriteWithoutFormat = supported.features.shaderStorageImageWriteWithoutFormat,
+         .shaderUniformBufferArrayDynamicIndexing = supported.features.shaderUniformBufferArrayDynamicIndexing,
+         .shaderSampledImageArrayDynamicIndexing = supported.features.shaderSampledImageArrayDynamicIndexing,
+         .shaderStorageBufferArrayDynamicIndexing = supported.features.shaderStorageBufferArrayDynamicIndexing,
+         .shaderStorageImageArrayDynamicIndexing = supported.features.shaderStorageImageArrayDynamicIndexing,
+         .shaderFloat64 = supported.features.shaderFloat64,
+         .shaderInt64 = supported.features.shaderInt64,
+         .shaderInt16 = supported.features.shaderInt16,
+         .shaderResourceMinLod = supported.features.shaderResourceMinLod,
+      },
+   };
+
+   static const char *extensions[] = {
+      "VK_KHR_pipeline_executable_properties",
+   };
+   const VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR exec_features = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_EXECUTABLE_PROPERTIES_FEATURES_KHR,
+      .pNext = &features,
+      .pipelineExecutableInfo = VK_TRUE,
+   };
+   const VkDeviceCreateInfo device_info = {
+      .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+      .pNext = &exec_features,
+      .enabledExtensionCount = ARRAY_SIZE(extensions),
+      .ppEnabledExtensionNames = extensions,
+   };
+   return CreateDevice(pdev, &device_info, NULL, &bench->device) == VK_SUCCESS;
+}
+
+static void
+print_usage(const char *name)
+{
+   fprintf(stderr,
+           "Usage: %s [options] shader.spv...\n"
+           "\n"
+           "Compiles SPIR-V compute shaders with RADV without a GPU and prints the results as JSON lines.\n"
+           "\n"
+           "Options:\n"
+           "  -f, --family=NAME     GPU family to compile for (default: navi21)\n"
+           "  -j, --threads=N       number of compiling threads (default: 1)\n"
+           "  -n, --iterations=N    compile every shader N times (default: 1)\n"
+           "  -c, --pipeline-cache  compile through a shared VkPipelineCache\n"
+           "  -d, --disk-cache      leave the on-disk shader cache enabled\n"
+           "  -o, --output=FILE     write the results to FILE instead of stdout\n"
+           "  -h, --help            show this help\n",
+           name);
+}
+
+int
+main(int argc, char **argv)
+{
+   static const struct option options[] = {
+      {"family", required_argument, NULL, 'f'},
+      {"threads", required_argument, NULL, 'j'},
+      {"iterations", required_argument, NULL, 'n'},
+      {"pipeline-cache", no_argument, NULL, 'c'},
+      {"disk-cache", no_argument, NULL, 'd'},
+      {"output", required_argument, NULL, 'o'},
+      {"help", no_argument, NULL, 'h'},
+      {NULL, 0, NULL, 0},
+   };
+
+   struct bench bench = {
+      .iterations = 1,
+      .out = stdout,
+   };
+   const char *family = "navi21";
+   unsigned num_threads = 1;
+   bool use_pipeline_cache = false;
+   bool use_disk_cache = false;
+
+   int opt;
+   while ((opt = getopt_long(argc, argv, "f:j:n:cdo:h", options, NULL)) != -1) {
+      switch (opt) {
+      case 'f':
+         family = optarg;
+         break;
+      case 'j':
+         num_threads = MAX2(atoi(optarg), 1);
+         break;
+      case 'n':
+         bench.iterations = MAX2(atoi(optarg), 1);
+         break;
+      case 'c':
+         use_pipeline_cache = true;
+         break;
+      case 'd':
+         use_disk_cache = true;
+         break;
+      case 'o':
+         bench.out = fopen(optarg, "w");
+         if (!bench.out) {
+            fprintf(stderr, "Failed to open %s\n", optarg);
+            return EXIT_FAILURE;
+         }
+         break;
+      case 'h':
+         print_usage(argv[0]);
+         return EXIT_SUCCESS;
+      default:
+         print_usage(argv[0]);
+         return EXIT_FAILURE;
+      }
+   }
+
+   if (optind >= argc) {
+      print_usage(argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   /* Results from a previous run would turn every compile into a cache hit. */
+   if (!use_disk_cache)
+      setenv("MESA_SHADER_CACHE_DISABLE", "true", 1);
+
+   if (!bench_create_device(&bench, family)) {
+      fprintf(stderr, "Failed to create a RADV device for %s\n", family);
+      return EXIT_FAILURE;
+   }
+
+   if (use_pipeline_cache) {
+      const VkPipelineCacheCreateInfo cache_info = {
+         .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+      };
+      CreatePipelineCache(bench.device, &cache_info, NULL, &bench.cache);
+   }
+
+   bench.num_shaders = argc - optind;
+   bench.shaders = calloc(bench.num_shaders, sizeof(*bench.shaders));
+   for (unsigned i = 0; i < bench.num_shaders; i++) {
+      struct bench_shader *shader = &bench.shaders[i];
+      shader->filename = argv[optind + i];
+
+      size_t size;
+      char *data = os_read_file(shader->filename, &size);
+      if (!data) {
+         shader->error = "failed to read the file";
+         continue;
+      }
+
+      shader->error = bench_shader_init(&bench, shader, (const uint32_t *)data, size / 4);
+      free(data);
+   }
+
+   mtx_init(&bench.out_lock, mtx_plain);
+
+   struct bench_thread *threads = calloc(num_threads, sizeof(*threads));
+   const int64_t start = os_time_get_nano();
+
+   unsigned started = 0;
+   for (unsigned i = 0; i < num_threads; i++) {
+      threads[i].bench = &bench;
+      threads[i].index = i;
+      if (u_thread_create(&threads[i].thread, bench_thread_main, &threads[i]) != thrd_success)
+         break;
+      started++;
+   }
+
+   /* Compile on the main thread too if no helper could be started. */
+   if (!started)
+      bench_thread_main(&(struct bench_thread){.bench = &bench});
+
+   for (unsigned i = 0; i < started; i++)
+      thrd_join(threads[i].thread, NULL);
+
+   const int64_t total_ns = os_time_get_nano() - start;
+
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+
+   fprintf(bench.out,
+           "{\"summary\": {\"family\": \"%s\", \"threads\": %u, \"shaders\": %u, \"iterations\": %u, "
+           "\"failed\": %u, \"cache_hits\": %u, \"total_ns\": %" PRId64 ", \"pipeline_ns\": %" PRIu64
+           ", \"peak_rss_kb\": %ld}}\n",
+           family, started ? started : 1, bench.num_shaders, bench.iterations, bench.failed, bench.cache_hits,
+           total_ns, bench.pipeline_ns, usage.ru_maxrss);
+
+   free(threads);
+   mtx_destroy(&bench.out_lock);
+
+   for (unsigned i = 0; i < bench.num_shaders; i++) {
+      if (bench.shaders[i].entrypoint)
+         bench_shader_finish(&bench, &bench.shaders[i]);
+   }
+   free(bench.shaders);
+
+   DestroyPipelineCache(bench.device, bench.cache, NULL);
+   DestroyDevice(bench.device, NULL);
+   DestroyInstance(bench.instance, NULL);
+
+   if (bench.out != stdout)
+      fclose(bench.out);
+
+   return bench.failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -69,6 +69,7 @@
 #define MAX_UNIFA_SKIP_DISTANCE 16
 
 struct nir_builder;
+struct disk_cache;
 
 struct v3d_fs_inputs {
         /**
@@ -1095,7 +1096,8 @@ vir_has_uniform(struct qinst *inst)
 }
 
 const struct v3d_compiler *v3d_compiler_init(const struct v3d_device_info *devinfo,
-                                             uint32_t max_inline_uniform_buffers);
+                                             uint32_t max_inline_uniform_buffers,
+                                             struct disk_cache *disk_cache);
 void v3d_compiler_free(const struct v3d_compiler *compiler);
 void v3d_optimize_nir(struct v3d_compile *c, struct nir_shader *s);
 
@@ -1200,7 +1202,8 @@ void v3d_vir_to_qpu(struct v3d_compile *c, struct qpu_reg *temp_registers);
 uint32_t v3d_qpu_schedule_instructions(struct v3d_compile *c);
 void qpu_validate(struct v3d_compile *c);
 struct qpu_reg *v3d_register_allocate(struct v3d_compile *c);
-bool vir_init_reg_sets(struct v3d_compiler *compiler);
+bool vir_init_reg_sets(struct v3d_compiler *compiler,
+                       struct disk_cache *disk_cache);
 
 int v3d_shaderdb_dump(struct v3d_compile *c, char **shaderdb_str);
 
@@ -496,7 +496,8 @@ vir_link_blocks(struct qblock *predecessor, struct qblock *successor)
 
 const struct v3d_compiler *
 v3d_compiler_init(const struct v3d_device_info *devinfo,
-                  uint32_t max_inline_uniform_buffers)
+                  uint32_t max_inline_uniform_buffers,
+                  struct disk_cache *disk_cache)
 {
         struct v3d_compiler *compiler = rzalloc(NULL, struct v3d_compiler);
         if (!compiler)
@@ -505,7 +506,7 @@ v3d_compiler_init(const struct v3d_device_info *devinfo,
         compiler->devinfo = devinfo;
         compiler->max_inline_uniform_buffers = max_inline_uniform_buffers;
 
-        if (!vir_init_reg_sets(compiler)) {
+        if (!vir_init_reg_sets(compiler, disk_cache)) {
                 ralloc_free(compiler);
                 return NULL;
         }
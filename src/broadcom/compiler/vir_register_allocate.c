@@ -999,7 +999,7 @@ v3d_ra_select_callback(unsigned int n, BITSET_WORD *regs, void *data)
 }
 
 bool
-vir_init_reg_sets(struct v3d_compiler *compiler)
+vir_init_reg_sets(struct v3d_compiler *compiler, struct disk_cache *disk_cache)
 {
         /* Allocate up to 3 regfile classes, for the ways the physical
          * register file can be divided up for fragment shader threading.
@@ -1049,7 +1049,7 @@ vir_init_reg_sets(struct v3d_compiler *compiler)
                 }
         }
 
-        ra_set_finalize(compiler->regs, NULL);
+        ra_set_finalize_cached(compiler->regs, disk_cache);
 
         return true;
 }
@@ -903,10 +903,6 @@ create_physical_device(struct v3dv_instance *instance,
    if (result != VK_SUCCESS)
       goto fail;
 
-   device->compiler = v3d_compiler_init(&device->devinfo,
-                                        MAX_INLINE_UNIFORM_BUFFERS);
-   device->next_program_id = 0;
-
    ASSERTED int len =
       asprintf(&device->name, "V3D %d.%d.%d",
                device->devinfo.ver / 10,
@@ -916,6 +912,11 @@ create_physical_device(struct v3dv_instance *instance,
 
    v3dv_physical_device_init_disk_cache(device);
 
+   device->compiler = v3d_compiler_init(&device->devinfo,
+                                        MAX_INLINE_UNIFORM_BUFFERS,
+                                        device->disk_cache);
+   device->next_program_id = 0;
+
    /* Setup available memory heaps and types */
    VkPhysicalDeviceMemoryProperties *mem = &device->memory;
    mem->memoryHeapCount = 1;
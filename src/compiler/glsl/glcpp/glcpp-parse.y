@@ -350,6 +350,7 @@ control_line_success:
       entry = _mesa_hash_table_search (parser->defines, $3);
       if (entry) {
          _mesa_hash_table_remove (parser->defines, entry);
+         parser->macro_generation++;
       }
    }
 |  HASH_TOKEN INCLUDE NEWLINE {
@@ -1499,6 +1500,9 @@ glcpp_parser_create(struct gl_context *gl_ctx,
                                              _mesa_key_string_equal);
    parser->linalloc = linear_context(parser);
    parser->active = NULL;
+   parser->expansion_memo = _mesa_pointer_hash_table_create(parser);
+   parser->macro_generation = 0;
+   parser->location_dependent_expansions = 0;
    parser->lexing_directive = 0;
    parser->lexing_version_directive = 0;
    parser->space_tokens = 1;
@@ -1964,19 +1968,28 @@ _glcpp_parser_expand_function(glcpp_parser_t *parser, token_node_t *node,
  *   As the token of the closing right parenthesis in the case of
  *   function-like macro expansion.
  *
+ * If the returned list is a memoized, already complete expansion of an
+ * object-like macro, *memoized is set to true and the caller need not
+ * rescan it. Otherwise, if the expansion is of an object-like macro whose
+ * result may be memoized once complete, *memo_macro is set to it.
+ *
  * See the documentation of _glcpp_parser_expand_token_list for a description
  * of the "mode" parameter.
  */
 static token_list_t *
 _glcpp_parser_expand_node(glcpp_parser_t *parser, token_node_t *node,
                           token_node_t *node_prev, token_node_t **last,
-                          expansion_mode_t mode, int line)
+                          expansion_mode_t mode, int line,
+                          bool *memoized, macro_t **memo_macro)
 {
    token_t *token = node->token;
    const char *identifier;
    struct hash_entry *entry;
    macro_t *macro;
 
+   *memoized = false;
+   *memo_macro = NULL;
+
    /* If token is already being expanded return to avoid an infinite loop */
    if (token->expanding)
       return NULL;
@@ -1992,12 +2005,16 @@ _glcpp_parser_expand_node(glcpp_parser_t *parser, token_node_t *node,
    /* Special handling for __LINE__ and __FILE__, (not through
     * the hash table). */
    if (*identifier == '_') {
-      if (strcmp(identifier, "__LINE__") == 0)
+      if (strcmp(identifier, "__LINE__") == 0) {
+         parser->location_dependent_expansions++;
          return _token_list_create_with_one_integer(parser, line);
+      }
 
-      if (strcmp(identifier, "__FILE__") == 0)
+      if (strcmp(identifier, "__FILE__") == 0) {
+         parser->location_dependent_expansions++;
          return _token_list_create_with_one_integer(parser,
                                                     node->token->location.source);
+      }
    }
 
    /* Look up this identifier in the hash table. */
@@ -2032,6 +2049,26 @@ _glcpp_parser_expand_node(glcpp_parser_t *parser, token_node_t *node,
       if (macro->replacements == NULL)
          return _token_list_create_with_one_space(parser);
 
+      /* The complete expansion of an object-like macro only depends on
+       * the current set of macros, as long as it's not nested in another
+       * expansion, (where the active list could block some of it), and
+       * not glued to a preceding unary +/- by the space logic below. */
+      if (mode == EXPANSION_MODE_IGNORE_DEFINED &&
+          parser->active == NULL &&
+          !(node_prev && (node_prev->token->type == '-' ||
+                          node_prev->token->type == '+'))) {
+         entry = _mesa_hash_table_search(parser->expansion_memo, macro);
+         if (entry) {
+            expansion_memo_t *memo = entry->data;
+            if (memo->generation == parser->macro_generation) {
+               *memoized = true;
+               return _token_list_copy(parser, memo->expansion);
+            }
+         }
+
+         *memo_macro = macro;
+      }
+
       replacement = _token_list_copy(parser, macro->replacements);
 
       /* If needed insert space in front of replacements to isolate them from
@@ -2069,8 +2106,10 @@ _parser_active_list_push(glcpp_parser_t *parser, const char *identifier,
 {
    active_list_t *node;
 
-   node = linear_alloc_child(parser->linalloc, sizeof(active_list_t));
-   node->identifier = linear_strdup(parser->linalloc, identifier);
+   /* Identifiers come from tokens which live as long as the parser, so
+    * there's no need to copy them. */
+   node = linear_zalloc_child(parser->linalloc, sizeof(active_list_t));
+   node->identifier = identifier;
    node->marker = marker;
    node->next = parser->active;
 
@@ -2100,12 +2139,56 @@ _parser_active_list_contains(glcpp_parser_t *parser, const char *identifier)
       return 0;
 
    for (node = parser->active; node; node = node->next)
-      if (strcmp(node->identifier, identifier) == 0)
+      if (node->identifier == identifier ||
+          strcmp(node->identifier, identifier) == 0)
          return 1;
 
    return 0;
 }
 
+/* Called when the list iterator reaches the marker of the top of the
+ * active list, (with 'marker' being NULL at the end of the list). If the
+ * macro being popped was flagged for memoization by
+ * _glcpp_parser_expand_node, record its now complete expansion.
+ */
+static void
+_glcpp_parser_memoize_expansion(glcpp_parser_t *parser, token_list_t *list,
+                                token_node_t *marker)
+{
+   active_list_t *active = parser->active;
+   token_node_t *node;
+   token_list_t *expansion;
+   expansion_memo_t *memo;
+
+   if (active->memo_macro == NULL ||
+       active->memo_generation != parser->macro_generation ||
+       active->memo_location_dependent !=
+          parser->location_dependent_expansions ||
+       active->memo_error != parser->error)
+      return;
+
+   expansion = _token_list_create(parser);
+   node = active->memo_prev ? active->memo_prev->next : list->head;
+   for (; node != marker; node = node->next) {
+      token_t *token = node->token;
+
+      /* A remaining function-like macro name could still be invoked by
+       * whatever follows the expansion, so the result isn't final. */
+      if (token->type == IDENTIFIER && !token->expanding &&
+          _mesa_hash_table_search(parser->defines, token->value.str))
+         return;
+
+      token_t *copy = linear_alloc_child(parser->linalloc, sizeof(token_t));
+      *copy = *token;
+      _token_list_append(parser, expansion, copy);
+   }
+
+   memo = linear_alloc_child(parser->linalloc, sizeof(expansion_memo_t));
+   memo->expansion = expansion;
+   memo->generation = parser->macro_generation;
+   _mesa_hash_table_insert(parser->expansion_memo, active->memo_macro, memo);
+}
+
 /* Walk over the token list replacing nodes with their expansion.
  * Whenever nodes are expanded the walking will walk over the new
  * nodes, continuing to expand as necessary. The results are placed in
@@ -2135,6 +2218,8 @@ _glcpp_parser_expand_token_list(glcpp_parser_t *parser, token_list_t *list,
    token_node_t *node, *last = NULL;
    token_list_t *expansion;
    active_list_t *active_initial = parser->active;
+   bool memoized;
+   macro_t *memo_macro;
    int line;
 
    if (list == NULL)
@@ -2152,11 +2237,14 @@ _glcpp_parser_expand_token_list(glcpp_parser_t *parser, token_list_t *list,
 
    while (node) {
 
-      while (parser->active && parser->active->marker == node)
+      while (parser->active && parser->active->marker == node) {
+         _glcpp_parser_memoize_expansion (parser, list, node);
          _parser_active_list_pop (parser);
+      }
 
       expansion =
-         _glcpp_parser_expand_node(parser, node, node_prev, &last, mode, line);
+         _glcpp_parser_expand_node(parser, node, node_prev, &last, mode, line,
+                                   &memoized, &memo_macro);
       if (expansion) {
          token_node_t *n;
 
@@ -2169,7 +2257,21 @@ _glcpp_parser_expand_token_list(glcpp_parser_t *parser, token_list_t *list,
                _parser_active_list_pop (parser);
             }
 
-         _parser_active_list_push(parser, node->token->value.str, last->next);
+         /* A memoized expansion is already complete, so skip over it
+          * rather than walking it again. */
+         if (!memoized) {
+            _parser_active_list_push(parser, node->token->value.str,
+                                     last->next);
+
+            if (memo_macro) {
+               parser->active->memo_macro = memo_macro;
+               parser->active->memo_prev = node_prev;
+               parser->active->memo_generation = parser->macro_generation;
+               parser->active->memo_location_dependent =
+                  parser->location_dependent_expansions;
+               parser->active->memo_error = parser->error;
+            }
+         }
 
          /* Splice expansion into list, supporting a simple deletion if the
           * expansion is empty.
@@ -2190,6 +2292,9 @@ _glcpp_parser_expand_token_list(glcpp_parser_t *parser, token_list_t *list,
             if (last == list->tail)
                list->tail = NULL;
          }
+
+         if (memoized && expansion->head)
+            node_prev = expansion->tail;
       } else {
          node_prev = node;
       }
@@ -2198,9 +2303,13 @@ _glcpp_parser_expand_token_list(glcpp_parser_t *parser, token_list_t *list,
 
    /* Remove any lingering effects of this invocation on the
     * active list. That is, pop until the list looks like it did
-    * at the beginning of this function. */
-   while (parser->active && parser->active != active_initial)
+    * at the beginning of this function. Expansions that ran up to
+    * the end of the list are complete at this point. */
+   while (parser->active && parser->active != active_initial) {
+      if (parser->active->marker == NULL)
+         _glcpp_parser_memoize_expansion (parser, list, NULL);
       _parser_active_list_pop (parser);
+   }
 
    list->non_space_tail = list->tail;
 }
@@ -2296,6 +2405,7 @@ _define_object_macro(glcpp_parser_t *parser, YYLTYPE *loc,
    }
 
    _mesa_hash_table_insert (parser->defines, identifier, macro);
+   parser->macro_generation++;
 }
 
 void
@@ -2331,6 +2441,7 @@ _define_function_macro(glcpp_parser_t *parser, YYLTYPE *loc,
    }
 
    _mesa_hash_table_insert(parser->defines, identifier, macro);
+   parser->macro_generation++;
 }
 
 static int
@@ -2585,4 +2696,5 @@ glcpp_parser_copy_defines(const void *key, void *data, void *closure)
    }
 
    _mesa_hash_table_insert(di->parser->defines, identifier, macro);
+   di->parser->macro_generation++;
 }
@@ -175,8 +175,23 @@ typedef struct active_list {
 	const char *identifier;
 	token_node_t *marker;
 	struct active_list *next;
+
+	/* Set when the complete expansion of this object-like macro can be
+	 * memoized once the list iterator reaches 'marker'. The expansion
+	 * then is everything after 'memo_prev', (or from the list head if
+	 * NULL), up to 'marker'. */
+	macro_t *memo_macro;
+	token_node_t *memo_prev;
+	unsigned memo_generation;
+	unsigned memo_location_dependent;
+	int memo_error;
 } active_list_t;
 
+typedef struct expansion_memo {
+	token_list_t *expansion;
+	unsigned generation;
+} expansion_memo_t;
+
 struct _mesa_glsl_parse_state;
 
 typedef void (*glcpp_extension_iterator)(
@@ -191,6 +206,17 @@ struct glcpp_parser {
 	yyscan_t scanner;
 	struct hash_table *defines;
 	active_list_t *active;
+
+	/* Fully expanded object-like macros, keyed by macro_t. Entries are
+	 * only valid while 'macro_generation' matches, which is bumped by
+	 * any change to 'defines'. */
+	struct hash_table *expansion_memo;
+	unsigned macro_generation;
+
+	/* Number of __LINE__/__FILE__ expansions so far. Expansions
+	 * involving these can't be memoized. */
+	unsigned location_dependent_expansions;
+
 	int lexing_directive;
 	int lexing_version_directive;
 	int space_tokens;
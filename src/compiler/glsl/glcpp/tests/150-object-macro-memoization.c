@@ -0,0 +1,19 @@
+#define foo bar
+#define bar 1 + baz
+#define baz 2
+foo
+foo
+-foo
+#undef baz
+#define baz 3
+foo
+#define f(x) (x)
+#define g f
+g(4)
+g
+g(5)
+#define A B
+#define B A
+A
+B
+A
@@ -178,6 +178,23 @@ struct fd_dev_info {
        */
       bool supports_ibo_ubwc;
 
+      /* Latency in cycles (with the base threadsize) until the result of
+       * an instruction synchronized with (ss) or (sy) can be used, and the
+       * minimum number of cycles between two instructions issued to the
+       * same unit. Only set these for GPUs where they have been measured,
+       * ir3 uses its own estimates for the ones left at zero. These only
+       * feed the scheduling heuristics and cycle estimates of ir3, the
+       * delays required for correctness are in ir3_delay.c.
+       */
+      uint32_t sfu_latency;
+      uint32_t local_mem_latency;
+      uint32_t ldc_latency;
+      uint32_t tex_latency;
+      uint32_t mem_latency;
+      uint32_t sfu_issue_cycles;
+      uint32_t tex_issue_cycles;
+      uint32_t mem_issue_cycles;
+
       struct {
          uint32_t PC_POWER_CNTL;
          uint32_t TPL1_DBG_ECO_CNTL;
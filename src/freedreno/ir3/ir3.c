@@ -296,6 +296,13 @@ ir3_collect_info(struct ir3_shader_variant *v)
    bool in_preamble = false;
    bool has_eq = false;
 
+   /* State for the cycle estimate: the cycle at which all outstanding (ss)
+    * and (sy) producers are done, and at which each unit can accept the
+    * next instruction.
+    */
+   uint32_t cycles = 0, ss_ready = 0, sy_ready = 0;
+   uint32_t unit_ready[IR3_UNIT_COUNT] = {0};
+
    foreach_block (block, &shader->block_list) {
       int sfu_delay = 0, mem_delay = 0;
 
@@ -392,6 +399,25 @@ ir3_collect_info(struct ir3_shader_variant *v)
                int n = MIN2(mem_delay, 1 + instr->repeat + instr->nop);
                mem_delay -= n;
             }
+
+            uint32_t issue = cycles;
+            if (instr->flags & IR3_INSTR_SS)
+               issue = MAX2(issue, ss_ready);
+            if (instr->flags & IR3_INSTR_SY)
+               issue = MAX2(issue, sy_ready);
+
+            enum ir3_unit unit = ir3_instr_unit(instr);
+            if (unit != IR3_UNIT_ALU) {
+               issue = MAX2(issue, unit_ready[unit]);
+               unit_ready[unit] = issue + ir3_unit_issue_cycles(compiler, unit);
+            }
+
+            cycles = issue + instrs_count;
+
+            if (is_ss_producer(instr))
+               ss_ready = MAX2(ss_ready, issue + ir3_instr_latency(compiler, instr));
+            if (is_sy_producer(instr))
+               sy_ready = MAX2(sy_ready, issue + ir3_instr_latency(compiler, instr));
          }
 
          if (instr->opc == OPC_SHPE)
@@ -399,6 +425,8 @@ ir3_collect_info(struct ir3_shader_variant *v)
       }
    }
 
+   info->cycles = cycles;
+
    /* for vertex shader, the inputs are loaded into registers before the shader
     * is executed, so max_regs from the shader instructions might not properly
     * reflect the # of registers actually used, especially in case passthrough
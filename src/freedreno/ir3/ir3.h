@@ -88,6 +88,11 @@ struct ir3_info {
 
    uint16_t last_helper; /* last instruction to use helper invocations */
 
+   /* estimate of the number of cycles it takes to execute every block
+    * once, using the latency model of the GPU
+    */
+   uint32_t cycles;
+
    /* Number of instructions of a given category: */
    uint16_t instrs_per_cat[8];
 };
@@ -1980,6 +1985,21 @@ soft_sy_delay(struct ir3_instruction *instr, struct ir3 *shader)
    }
 }
 
+/* Latency model of the GPU, see ir3_compiler::latency: */
+enum ir3_unit {
+   IR3_UNIT_ALU,
+   IR3_UNIT_SFU,
+   IR3_UNIT_TEX,
+   IR3_UNIT_MEM,
+   IR3_UNIT_COUNT,
+};
+
+enum ir3_unit ir3_instr_unit(struct ir3_instruction *instr);
+unsigned ir3_unit_issue_cycles(const struct ir3_compiler *compiler,
+                               enum ir3_unit unit);
+unsigned ir3_instr_latency(const struct ir3_compiler *compiler,
+                           struct ir3_instruction *instr);
+
 bool ir3_opt_predicates(struct ir3 *ir, struct ir3_shader_variant *v);
 
 /* unreachable block elimination: */
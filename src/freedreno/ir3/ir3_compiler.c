@@ -49,6 +49,7 @@ static const struct debug_named_value shader_debug_options[] = {
    {"nopreamble", IR3_DBG_NOPREAMBLE, "Disable the preamble pass"},
    {"fullsync",   IR3_DBG_FULLSYNC,   "Add (sy) + (ss) after each cat5/cat6"},
    {"fullnop",    IR3_DBG_FULLNOP,    "Add nops before each instruction"},
+   {"ilpsched",   IR3_DBG_ILPSCHED,   "Schedule post-RA for ILP using the latency model of the GPU"},
 #if MESA_DEBUG
    /* MESA_DEBUG-only options: */
    {"schedmsgs",  IR3_DBG_SCHEDMSGS,  "Enable scheduler debug messages"},
@@ -231,6 +232,36 @@ ir3_compiler_create(struct fd_device *dev, const struct fd_dev_id *dev_id,
       compiler->max_const_safe = 256;
    }
 
+   /* Estimated latency model. sfu, ldc and tex are the single warp, cached
+    * data delay slot counts that soft_ss_delay() and soft_sy_delay() are
+    * based on, the memory latency and the issue rates are rough estimates.
+    * GPUs with measured numbers override them in freedreno_devices.py.
+    */
+   compiler->latency.sfu = 10;
+   compiler->latency.local_mem = 10;
+   compiler->latency.ldc = 22;
+   compiler->latency.tex = 51;
+   compiler->latency.mem = 110;
+   compiler->latency.sfu_issue = 4;
+   compiler->latency.tex_issue = 4;
+   compiler->latency.mem_issue = 4;
+
+   if (compiler->gen >= 6) {
+#define LATENCY(field, prop)                                                   \
+   if (dev_info->a6xx.prop)                                                    \
+      compiler->latency.field = dev_info->a6xx.prop;
+
+      LATENCY(sfu, sfu_latency)
+      LATENCY(local_mem, local_mem_latency)
+      LATENCY(ldc, ldc_latency)
+      LATENCY(tex, tex_latency)
+      LATENCY(mem, mem_latency)
+      LATENCY(sfu_issue, sfu_issue_cycles)
+      LATENCY(tex_issue, tex_issue_cycles)
+      LATENCY(mem_issue, mem_issue_cycles)
+#undef LATENCY
+   }
+
    /* This is just a guess for a4xx. */
    compiler->pvtmem_per_fiber_align = compiler->gen >= 4 ? 512 : 128;
    /* TODO: implement private memory on earlier gen's */
@@ -264,6 +264,20 @@ struct ir3_compiler {
 
    bool load_shader_consts_via_preamble;
    bool load_inline_uniforms_via_preamble_ldgk;
+
+   /* Latency model used by the ILP scheduler and the cycle estimate in
+    * ir3_collect_info(), see the comment on fd_dev_info::a6xx::sfu_latency.
+    */
+   struct {
+      unsigned sfu;
+      unsigned local_mem;
+      unsigned ldc;
+      unsigned tex;
+      unsigned mem;
+      unsigned sfu_issue;
+      unsigned tex_issue;
+      unsigned mem_issue;
+   } latency;
 };
 
 void ir3_compiler_destroy(struct ir3_compiler *compiler);
@@ -316,6 +330,7 @@ enum ir3_shader_debug {
    IR3_DBG_SHADER_INTERNAL = BITFIELD_BIT(14),
    IR3_DBG_FULLSYNC = BITFIELD_BIT(15),
    IR3_DBG_FULLNOP = BITFIELD_BIT(16),
+   IR3_DBG_ILPSCHED = BITFIELD_BIT(17),
 
    /* MESA_DEBUG-only options: */
    IR3_DBG_SCHEDMSGS = BITFIELD_BIT(20),
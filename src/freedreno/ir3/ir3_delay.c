@@ -25,6 +25,7 @@
  */
 
 #include "ir3.h"
+#include "ir3_compiler.h"
 
 /* The maximum number of nop's we may need to insert between two instructions.
  */
@@ -336,3 +337,75 @@ ir3_delay_calc(struct ir3_block *block, struct ir3_instruction *instr,
 
    return delay_calc(block, NULL, instr, 0, &mask, mergedregs);
 }
+
+/*
+ * Latency model, used for scheduling heuristics and cycle estimates. Unlike
+ * the delays above, getting these wrong only costs performance.
+ */
+
+enum ir3_unit
+ir3_instr_unit(struct ir3_instruction *instr)
+{
+   if (is_sfu(instr))
+      return IR3_UNIT_SFU;
+   if (is_tex_or_prefetch(instr))
+      return IR3_UNIT_TEX;
+   if (is_mem(instr))
+      return IR3_UNIT_MEM;
+   return IR3_UNIT_ALU;
+}
+
+/* Minimum number of cycles between issuing two instructions to a unit. */
+unsigned
+ir3_unit_issue_cycles(const struct ir3_compiler *compiler, enum ir3_unit unit)
+{
+   switch (unit) {
+   case IR3_UNIT_SFU:
+      return compiler->latency.sfu_issue;
+   case IR3_UNIT_TEX:
+      return compiler->latency.tex_issue;
+   case IR3_UNIT_MEM:
+      return compiler->latency.mem_issue;
+   default:
+      return 1;
+   }
+}
+
+/* Estimated number of cycles until the result of an (ss) or (sy) producer
+ * is available. Other instructions return 0, their results are waited on
+ * with nops.
+ */
+unsigned
+ir3_instr_latency(const struct ir3_compiler *compiler,
+                  struct ir3_instruction *instr)
+{
+   if (is_ss_producer(instr)) {
+      if (is_sfu(instr))
+         return compiler->latency.sfu;
+      if (is_local_mem_load(instr))
+         return compiler->latency.local_mem;
+      return soft_ss_delay(instr);
+   }
+
+   if (!is_sy_producer(instr))
+      return 0;
+
+   unsigned components = instr->dsts_count ? reg_elems(instr->dsts[0]) : 1;
+   unsigned latency;
+   if (instr->opc == OPC_LDC)
+      latency = compiler->latency.ldc + 4 * (components - 1);
+   else if (is_tex_or_prefetch(instr))
+      latency = compiler->latency.tex + 4 * (components - 1);
+   else
+      latency = compiler->latency.mem;
+
+   /* Like in soft_sy_delay(), most ALU instructions take two cycles with the
+    * doubled wavesize, so it takes half as many instructions to hide the
+    * latency.
+    */
+   gl_shader_stage type = instr->block->shader->type;
+   if (type == MESA_SHADER_FRAGMENT || type == MESA_SHADER_COMPUTE)
+      latency /= 2;
+
+   return latency;
+}
@@ -72,6 +72,10 @@ struct ir3_postsched_ctx {
 
    int ss_delay;
    int sy_delay;
+
+   /* IR3_SHADER_DEBUG=ilpsched, see choose_instr_ilp(): */
+   bool ilp;
+   unsigned unit_ready[IR3_UNIT_COUNT];
 };
 
 struct ir3_postsched_node {
@@ -85,6 +89,13 @@ struct ir3_postsched_node {
 
    unsigned delay;
    unsigned max_delay;
+
+   /* Like earliest_ip/delay/max_delay, but using the latency model of the
+    * GPU for (ss)/(sy) sources, for the ILP mode:
+    */
+   unsigned soft_earliest_ip;
+   unsigned ilp_delay;
+   unsigned critical_path;
 };
 
 #define foreach_sched_node(__n, __list)                                        \
@@ -132,13 +143,30 @@ schedule(struct ir3_postsched_ctx *ctx, struct ir3_instruction *instr)
    /* We insert any nop's needed to get to earliest_ip, then advance
     * delay_cycles by scheduling the instruction.
     */
-   ctx->ip = MAX2(ctx->ip, n->earliest_ip) + delay_cycles;
+   unsigned issue_ip = MAX2(ctx->ip, n->earliest_ip);
+   ctx->ip = issue_ip + delay_cycles;
+
+   unsigned latency = 0;
+   if (ctx->ilp) {
+      enum ir3_unit unit = ir3_instr_unit(instr);
+      if (unit != IR3_UNIT_ALU) {
+         ctx->unit_ready[unit] =
+            issue_ip + ir3_unit_issue_cycles(ctx->ir->compiler, unit);
+      }
+      latency = ir3_instr_latency(ctx->ir->compiler, instr);
+   }
 
    util_dynarray_foreach (&n->dag.edges, struct dag_edge, edge) {
       unsigned delay = (unsigned)(uintptr_t)edge->data;
       struct ir3_postsched_node *child =
          container_of(edge->child, struct ir3_postsched_node, dag);
       child->earliest_ip = MAX2(child->earliest_ip, ctx->ip + delay);
+
+      if (latency && ((is_ss_producer(instr) && child->has_ss_src) ||
+                      (is_sy_producer(instr) && child->has_sy_src))) {
+         child->soft_earliest_ip =
+            MAX2(child->soft_earliest_ip, issue_ip + latency);
+      }
    }
 
    list_addtail(&instr->node, &instr->block->instr_list);
@@ -205,6 +233,48 @@ node_delay_soft(struct ir3_postsched_ctx *ctx, struct ir3_postsched_node *n)
    return delay;
 }
 
+static unsigned
+node_stall_ilp(struct ir3_postsched_ctx *ctx, struct ir3_postsched_node *n)
+{
+   unsigned ready = MAX2(n->earliest_ip, n->soft_earliest_ip);
+
+   enum ir3_unit unit = ir3_instr_unit(n->instr);
+   if (unit != IR3_UNIT_ALU)
+      ready = MAX2(ready, ctx->unit_ready[unit]);
+
+   return MAX2(ready, ctx->ip) - ctx->ip;
+}
+
+/* Classic list scheduling for ILP: among the leaders that would stall the
+ * least (on nops, (ss)/(sy) or a busy unit), pick the one with the longest
+ * latency-weighted path to the end of the block.
+ */
+static struct ir3_instruction *
+choose_instr_ilp(struct ir3_postsched_ctx *ctx)
+{
+   struct ir3_postsched_node *chosen = NULL;
+   unsigned chosen_stall = 0;
+
+   foreach_sched_node (n, &ctx->dag->heads) {
+      unsigned stall = node_stall_ilp(ctx, n);
+
+      if (!chosen || stall < chosen_stall ||
+          (stall == chosen_stall &&
+           chosen->critical_path < n->critical_path)) {
+         chosen = n;
+         chosen_stall = stall;
+      }
+   }
+
+   if (chosen) {
+      di(chosen->instr, "ilp: chose (stall=%u, path=%u)", chosen_stall,
+         chosen->critical_path);
+      return chosen->instr;
+   }
+
+   return NULL;
+}
+
 /* find instruction to schedule: */
 static struct ir3_instruction *
 choose_instr(struct ir3_postsched_ctx *ctx)
@@ -262,6 +332,9 @@ choose_instr(struct ir3_postsched_ctx *ctx)
       return chosen->instr;
    }
 
+   if (ctx->ilp)
+      return choose_instr_ilp(ctx);
+
    /* Next prioritize expensive instructions: */
    foreach_sched_node (n, &ctx->dag->heads) {
       unsigned d = node_delay_soft(ctx, n);
@@ -411,6 +484,10 @@ add_single_reg_dep(struct ir3_postsched_deps_state *state,
       unsigned d_soft = ir3_delayslots(dep->instr, node->instr, src_n, true);
       d = ir3_delayslots_with_repeat(dep->instr, node->instr, dst_n, src_n);
       node->delay = MAX2(node->delay, d_soft);
+      node->ilp_delay = MAX2(node->ilp_delay, d);
+      node->ilp_delay =
+         MAX2(node->ilp_delay,
+              ir3_instr_latency(state->ctx->ir->compiler, dep->instr));
       if (is_sy_producer(dep->instr))
          node->has_sy_src = true;
       if (is_ss_producer(dep->instr))
@@ -557,6 +634,24 @@ sched_dag_max_delay_cb(struct dag_node *node, void *state)
    n->max_delay = MAX2(n->max_delay, max_delay + n->delay);
 }
 
+static void
+sched_dag_critical_path_cb(struct dag_node *node, void *state)
+{
+   struct ir3_postsched_node *n = (struct ir3_postsched_node *)node;
+   unsigned critical_path = 0;
+
+   util_dynarray_foreach (&n->dag.edges, struct dag_edge, edge) {
+      struct ir3_postsched_node *child =
+         (struct ir3_postsched_node *)edge->child;
+      critical_path = MAX2(child->critical_path, critical_path);
+   }
+
+   if (is_alu(n->instr) || is_flow(n->instr))
+      critical_path += 1 + n->instr->repeat;
+
+   n->critical_path = critical_path + n->ilp_delay;
+}
+
 static void
 sched_dag_init(struct ir3_postsched_ctx *ctx)
 {
@@ -633,6 +728,9 @@ sched_dag_init(struct ir3_postsched_ctx *ctx)
 
    // TODO do we want to do this after reverse-dependencies?
    dag_traverse_bottom_up(ctx->dag, sched_dag_max_delay_cb, NULL);
+
+   if (ctx->ilp)
+      dag_traverse_bottom_up(ctx->dag, sched_dag_critical_path_cb, NULL);
 }
 
 static void
@@ -649,6 +747,7 @@ sched_block(struct ir3_postsched_ctx *ctx, struct ir3_block *block)
    ctx->block = block;
    ctx->sy_delay = 0;
    ctx->ss_delay = 0;
+   memset(ctx->unit_ready, 0, sizeof(ctx->unit_ready));
 
    /* The terminator has to stay at the end. Instead of trying to set up
     * dependencies to achieve this, it's easier to just remove it now and add it
@@ -768,6 +867,7 @@ ir3_postsched(struct ir3 *ir, struct ir3_shader_variant *v)
    struct ir3_postsched_ctx ctx = {
       .ir = ir,
       .v = v,
+      .ilp = !!(ir3_shader_debug & IR3_DBG_ILPSCHED),
    };
 
    cleanup_self_movs(ir);
@@ -250,7 +250,7 @@ alloc_variant(struct ir3_shader *shader, const struct ir3_shader_key *key,
    if (!v)
       return NULL;
 
-   v->id = ++shader->variant_count;
+   v->id = p_atomic_inc_return(&shader->variant_count);
    v->shader_id = shader->id;
    v->binning_pass = !!nonbinning;
    v->nonbinning = nonbinning;
@@ -342,6 +342,8 @@ create_variant(struct ir3_shader *shader, const struct ir3_shader_key *key,
    if (ir3_disk_cache_retrieve(shader, v))
       return v;
 
+   /* Variants can be compiled concurrently, but the NIR is shared: */
+   mtx_lock(&shader->variants_lock);
    if (!shader->nir_finalized) {
       ir3_nir_post_finalize(shader);
 
@@ -356,6 +358,7 @@ create_variant(struct ir3_shader *shader, const struct ir3_shader_key *key,
 
       shader->nir_finalized = true;
    }
+   mtx_unlock(&shader->variants_lock);
 
    if (!compile_variant(shader, v))
       goto fail;
@@ -380,18 +383,115 @@ ir3_shader_create_variant(struct ir3_shader *shader,
    return create_variant(shader, key, keep_ir, NULL);
 }
 
+/* This doesn't need variants_lock: variants are only ever prepended to the
+ * list, and they are fully initialized before being published with release
+ * semantics by publish_variant().
+ */
 static inline struct ir3_shader_variant *
 shader_variant(struct ir3_shader *shader, const struct ir3_shader_key *key)
 {
    struct ir3_shader_variant *v;
 
-   for (v = shader->variants; v; v = v->next)
+   for (v = p_atomic_read(&shader->variants); v; v = v->next)
       if (ir3_shader_key_equal(key, &v->key))
          return v;
 
    return NULL;
 }
 
+/* Called with variants_lock held, which serializes the writers. */
+static void
+publish_variant(struct ir3_shader *shader, struct ir3_shader_variant *v)
+{
+   v->next = shader->variants;
+   p_atomic_set(&shader->variants, v);
+}
+
+struct ir3_variant_compile {
+   struct ir3_variant_compile *next;
+   struct ir3_shader_key key;
+   struct ir3_shader_variant *v;
+   /* Signaled when done, only threads waiting for this key wake up: */
+   cnd_t cond;
+   unsigned refcount;
+   bool done;
+};
+
+static struct ir3_variant_compile *
+variant_in_flight(struct ir3_shader *shader, const struct ir3_shader_key *key)
+{
+   struct ir3_variant_compile *c;
+
+   for (c = shader->variants_in_flight; c; c = c->next)
+      if (ir3_shader_key_equal(key, &c->key))
+         return c;
+
+   return NULL;
+}
+
+static void
+remove_variant_in_flight(struct ir3_shader *shader,
+                         struct ir3_variant_compile *c)
+{
+   struct ir3_variant_compile **p = &shader->variants_in_flight;
+
+   while (*p != c)
+      p = &(*p)->next;
+   *p = c->next;
+}
+
+/* Called with variants_lock held, which is dropped while compiling so that
+ * lookups and compiles of other keys aren't serialized behind this one.
+ */
+static struct ir3_shader_variant *
+compile_variant_unlocked(struct ir3_shader *shader,
+                         const struct ir3_shader_key *key, bool write_disasm,
+                         bool *created)
+{
+   struct ir3_shader_variant *v;
+   struct ir3_variant_compile *c = variant_in_flight(shader, key);
+
+   if (c) {
+      /* Another thread is already compiling this key, wait for it: */
+      c->refcount++;
+      while (!c->done)
+         cnd_wait(&c->cond, &shader->variants_lock);
+      v = c->v;
+   } else {
+      c = calloc(1, sizeof(*c));
+      if (!c)
+         return NULL;
+
+      cnd_init(&c->cond);
+      c->key = *key;
+      c->refcount = 1;
+      c->next = shader->variants_in_flight;
+      shader->variants_in_flight = c;
+
+      mtx_unlock(&shader->variants_lock);
+      v = create_variant(shader, key, write_disasm, NULL);
+      mtx_lock(&shader->variants_lock);
+
+      if (v) {
+         ralloc_steal(shader, v);
+         publish_variant(shader, v);
+         *created = true;
+      }
+
+      remove_variant_in_flight(shader, c);
+      c->v = v;
+      c->done = true;
+      cnd_broadcast(&c->cond);
+   }
+
+   if (--c->refcount == 0) {
+      cnd_destroy(&c->cond);
+      free(c);
+   }
+
+   return v;
+}
+
 struct ir3_shader_variant *
 ir3_shader_get_variant(struct ir3_shader *shader,
                        const struct ir3_shader_key *key, bool binning_pass,
@@ -399,17 +499,20 @@ ir3_shader_get_variant(struct ir3_shader *shader,
 {
    MESA_TRACE_FUNC();
 
-   mtx_lock(&shader->variants_lock);
    struct ir3_shader_variant *v = shader_variant(shader, key);
 
    if (!v) {
-      /* compile new variant if it doesn't exist already: */
-      v = create_variant(shader, key, write_disasm, shader);
-      if (v) {
-         v->next = shader->variants;
-         shader->variants = v;
-         *created = true;
+      mtx_lock(&shader->variants_lock);
+
+      /* It may have been published since the lock-free lookup: */
+      v = shader_variant(shader, key);
+
+      if (!v) {
+         /* compile new variant if it doesn't exist already: */
+         v = compile_variant_unlocked(shader, key, write_disasm, created);
       }
+
+      mtx_unlock(&shader->variants_lock);
    }
 
    if (v && binning_pass) {
@@ -417,8 +520,6 @@ ir3_shader_get_variant(struct ir3_shader *shader,
       assert(v);
    }
 
-   mtx_unlock(&shader->variants_lock);
-
    return v;
 }
 
@@ -475,6 +576,7 @@ ir3_shader_destroy(struct ir3_shader *shader)
       }
    }
    ralloc_free(shader->nir);
+   assert(!shader->variants_in_flight);
    mtx_destroy(&shader->variants_lock);
    ralloc_free(shader);
 }
@@ -876,6 +876,8 @@ ir3_has_binning_vs(const struct ir3_shader_key *key)
    return true;
 }
 
+struct ir3_variant_compile;
+
 /**
  * Represents a shader at the API level, before state-specific variants are
  * generated.
@@ -918,9 +920,20 @@ struct ir3_shader {
       } vs;
    };
 
+   /* Compiled variants. New ones are added at the head with p_atomic_set(),
+    * so lookups can walk the list without variants_lock. The lock protects
+    * changes to variants and variants_in_flight, and isn't held while a
+    * variant is compiled.
+    */
    struct ir3_shader_variant *variants;
    mtx_t variants_lock;
 
+   /* Variants being compiled without holding variants_lock.  Threads that
+    * request one of these keys wait on its condition variable instead of
+    * compiling a duplicate.
+    */
+   struct ir3_variant_compile *variants_in_flight;
+
    cache_key cache_key; /* shader disk-cache key */
 
    /* Bitmask of bits of the shader key used by this shader.  Used to avoid
@@ -0,0 +1,193 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <err.h>
+#include <stdio.h>
+
+#include "c11/threads.h"
+#include "compiler/glsl_types.h"
+#include "compiler/nir/nir_builder.h"
+#include "util/u_thread.h"
+
+#include "ir3_compiler.h"
+#include "ir3_nir.h"
+#include "ir3_shader.h"
+
+/*
+ * Stress test for concurrent ir3_shader_get_variant(): many threads request
+ * overlapping keys of the same shader at once, in different orders.  Every
+ * key must be compiled exactly once, and every thread must get the same
+ * variant for a given key.
+ */
+
+#define NUM_THREADS 16
+#define NUM_KEYS    8
+#define NUM_ROUNDS  8
+#define NUM_REPEATS 4
+
+struct thread_data {
+   struct ir3_shader *shader;
+   util_barrier *barrier;
+   unsigned idx;
+   struct ir3_shader_variant *variants[NUM_KEYS];
+   unsigned created;
+   bool mismatch;
+};
+
+static void
+init_key(struct ir3_shader_key *key, unsigned k)
+{
+   memset(key, 0, sizeof(*key));
+   /* Doesn't change the compiled code of a compute shader, but makes the
+    * keys distinct, including the slow memcmp() path of
+    * ir3_shader_key_equal():
+    */
+   key->has_per_samp = true;
+   key->vsamples = k;
+}
+
+static int
+get_variants_thread(void *data)
+{
+   struct thread_data *t = data;
+
+   util_barrier_wait(t->barrier);
+
+   for (unsigned r = 0; r < NUM_REPEATS; r++) {
+      for (unsigned i = 0; i < NUM_KEYS; i++) {
+         /* Every thread walks the keys in a different order: */
+         unsigned k = (i + t->idx * (r + 1)) % NUM_KEYS;
+         struct ir3_shader_key key;
+         bool created = false;
+
+         init_key(&key, k);
+
+         struct ir3_shader_variant *v =
+            ir3_shader_get_variant(t->shader, &key, false, false, &created);
+
+         if (r == 0)
+            t->variants[k] = v;
+         else if (t->variants[k] != v)
+            t->mismatch = true;
+
+         t->created += created;
+      }
+   }
+
+   return 0;
+}
+
+static nir_shader *
+build_shader(struct ir3_compiler *c)
+{
+   nir_builder b = nir_builder_init_simple_shader(
+      MESA_SHADER_COMPUTE, ir3_get_compiler_options(c), "variant stress");
+
+   b.shader->info.num_ssbos = 1;
+   b.shader->info.workgroup_size[0] = 64;
+   b.shader->info.workgroup_size[1] = 1;
+   b.shader->info.workgroup_size[2] = 1;
+
+   nir_def *zero = nir_imm_int(&b, 0);
+   nir_def *x = nir_load_ssbo(&b, 1, 32, zero, zero, .align_mul = 4);
+
+   /* Some ALU work, so that compiles last long enough to overlap: */
+   for (unsigned i = 0; i < 64; i++)
+      x = nir_ffma(&b, x, x, nir_imm_float(&b, i));
+
+   nir_store_ssbo(&b, x, zero, nir_imm_int(&b, 4), .align_mul = 4);
+
+   ir3_finalize_nir(c, b.shader);
+
+   return b.shader;
+}
+
+static int
+run_round(struct ir3_compiler *c, unsigned round)
+{
+   struct ir3_shader_options options = {};
+   struct ir3_shader *shader =
+      ir3_shader_from_nir(c, build_shader(c), &options, NULL);
+   struct thread_data threads[NUM_THREADS] = {};
+   thrd_t handles[NUM_THREADS];
+   util_barrier barrier;
+   int result = 0;
+
+   util_barrier_init(&barrier, NUM_THREADS);
+
+   for (unsigned i = 0; i < NUM_THREADS; i++) {
+      threads[i].shader = shader;
+      threads[i].barrier = &barrier;
+      threads[i].idx = i;
+      if (thrd_create(&handles[i], get_variants_thread, &threads[i]) !=
+          thrd_success)
+         errx(1, "could not create thread");
+   }
+
+   for (unsigned i = 0; i < NUM_THREADS; i++)
+      thrd_join(handles[i], NULL);
+
+   util_barrier_destroy(&barrier);
+
+   unsigned created = 0;
+   for (unsigned i = 0; i < NUM_THREADS; i++) {
+      for (unsigned k = 0; k < NUM_KEYS; k++) {
+         if (!threads[i].variants[k] || threads[i].mismatch ||
+             threads[i].variants[k] != threads[0].variants[k]) {
+            printf("%u: FAIL: thread %u got a different variant for key %u\n",
+                   round, i, k);
+            result = -1;
+         }
+      }
+      created += threads[i].created;
+   }
+
+   unsigned listed = 0;
+   for (struct ir3_shader_variant *v = shader->variants; v; v = v->next)
+      listed++;
+
+   if (created != NUM_KEYS || listed != NUM_KEYS ||
+       shader->variant_count != NUM_KEYS) {
+      printf("%u: FAIL: %u keys, but %u created, %u listed and %u compiled\n",
+             round, NUM_KEYS, created, listed, shader->variant_count);
+      result = -1;
+   }
+
+   if (!result)
+      printf("%u: PASS\n", round);
+
+   ir3_shader_destroy(shader);
+
+   return result;
+}
+
+int
+main(int argc, char **argv)
+{
+   struct ir3_compiler *c;
+   int result = 0;
+
+   struct fd_dev_id dev_id = {
+         .gpu_id = 630,
+   };
+
+   glsl_type_singleton_init_or_ref();
+
+   c = ir3_compiler_create(NULL, &dev_id, fd_dev_info_raw(&dev_id),
+                           &(struct ir3_compiler_options){
+                              .disable_cache = true,
+                           });
+
+   for (unsigned i = 0; i < NUM_ROUNDS; i++) {
+      if (run_round(c, i))
+         result = -1;
+   }
+
+   ir3_compiler_destroy(c);
+
+   glsl_type_singleton_decref();
+
+   return result;
+}
@@ -4493,6 +4493,15 @@ tu_GetPipelineExecutableStatisticsKHR(
       stat->value.u64 = exe->stats.systall;
    }
 
+   vk_outarray_append_typed(VkPipelineExecutableStatisticKHR, &out, stat) {
+      WRITE_STR(stat->name, "Estimated cycles");
+      WRITE_STR(stat->description,
+                "Estimated cycles to execute every block once, based on the "
+                "latency model of the GPU.");
+      stat->format = VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_UINT64_KHR;
+      stat->value.u64 = exe->stats.cycles;
+   }
+
    for (int i = 0; i < ARRAY_SIZE(exe->stats.instrs_per_cat); i++) {
       vk_outarray_append_typed(VkPipelineExecutableStatisticKHR, &out, stat) {
          WRITE_STR(stat->name, "cat%d instructions", i);
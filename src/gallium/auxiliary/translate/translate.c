@@ -31,9 +31,14 @@
   */
 
 #include "util/detect.h"
+#include "util/u_debug.h"
 #include "pipe/p_state.h"
 #include "translate.h"
 
+#if DRAW_LLVM_AVAILABLE
+DEBUG_GET_ONCE_BOOL_OPTION(translate_llvm, "GALLIUM_TRANSLATE_LLVM", true)
+#endif
+
 struct translate *translate_create( const struct translate_key *key )
 {
    struct translate *translate = NULL;
@@ -42,10 +47,17 @@ struct translate *translate_create( const struct translate_key *key )
    translate = translate_sse2_create( key );
    if (translate)
       return translate;
-#else
-   (void)translate;
 #endif
 
+#if DRAW_LLVM_AVAILABLE
+   if (debug_get_option_translate_llvm()) {
+      translate = translate_llvm_create( key );
+      if (translate)
+         return translate;
+   }
+#endif
+
+   (void)translate;
    return translate_generic_create( key );
 }
 
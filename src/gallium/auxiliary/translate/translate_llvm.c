@@ -0,0 +1,522 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * Vertex translation compiled to native code with gallivm.
+ *
+ * Every translate key gets its own loop, with the fetch code of each input
+ * format inlined by lp_build_fetch_rgba_aos(). LLVM targets the host CPU,
+ * which lets it use AVX2, AVX-512 or NEON where translate_sse.c only knows
+ * SSE2.
+ *
+ * Only the outputs the draw module and u_vbuf use are implemented:
+ * 32-bit floats, copies where the input and output formats are the same
+ * and instance IDs, and only from inputs gallivm can fetch inline.
+ * translate_llvm_create() returns NULL for anything else.
+ */
+
+#include "util/u_math.h"
+#include "util/u_memory.h"
+#include "util/format/u_format.h"
+#include "pipe/p_state.h"
+#include "translate.h"
+
+#include "gallivm/lp_bld_const.h"
+#include "gallivm/lp_bld_flow.h"
+#include "gallivm/lp_bld_format.h"
+#include "gallivm/lp_bld_init.h"
+#include "gallivm/lp_bld_type.h"
+
+
+/** The input of an element, as set by set_buffer(). */
+struct translate_llvm_input {
+   const uint8_t *ptr;
+   unsigned stride;
+   unsigned max_index;
+};
+
+enum translate_llvm_member {
+   TRANSLATE_LLVM_INPUT_PTR,
+   TRANSLATE_LLVM_INPUT_STRIDE,
+   TRANSLATE_LLVM_INPUT_MAX_INDEX,
+   TRANSLATE_LLVM_INPUT_NUM_MEMBERS
+};
+
+/**
+ * The signature of the compiled functions. "elts" is NULL for linear
+ * runs, in which case the vertices are start..start+count-1.
+ * "count" must not be 0.
+ */
+typedef void (*translate_llvm_run_func)(const struct translate_llvm_input *inputs,
+                                        const void *elts,
+                                        unsigned start,
+                                        unsigned count,
+                                        unsigned start_instance,
+                                        unsigned instance_id,
+                                        void *output_buffer);
+
+struct translate_llvm {
+   struct translate translate;
+
+   LLVMContextRef context;
+   struct gallivm_state *gallivm;
+
+   /* Indexed by the index size in bytes, 0 for linear runs. */
+   translate_llvm_run_func run_func[5];
+
+   struct translate_llvm_input inputs[TRANSLATE_MAX_ATTRIBS];
+};
+
+
+static struct translate_llvm *
+translate_llvm(struct translate *translate)
+{
+   return (struct translate_llvm *)translate;
+}
+
+
+static bool
+is_float32_output(enum pipe_format format)
+{
+   switch (format) {
+   case PIPE_FORMAT_R32_FLOAT:
+   case PIPE_FORMAT_R32G32_FLOAT:
+   case PIPE_FORMAT_R32G32B32_FLOAT:
+   case PIPE_FORMAT_R32G32B32A32_FLOAT:
+      return true;
+   default:
+      return false;
+   }
+}
+
+
+static bool
+is_copy_element(const struct translate_element *element)
+{
+   const struct util_format_description *desc =
+      util_format_description(element->input_format);
+
+   return element->input_format == element->output_format &&
+          desc->block.width == 1 && desc->block.height == 1 &&
+          !(desc->block.bits & 7);
+}
+
+
+/**
+ * Whether lp_build_fetch_rgba_aos() converts this format inline. Other
+ * formats go through a call to the u_format fetch function per vertex,
+ * which is much slower than what translate_generic.c does.
+ */
+static bool
+has_inline_fetch(const struct util_format_description *desc)
+{
+   if (desc->layout != UTIL_FORMAT_LAYOUT_PLAIN ||
+       desc->colorspace != UTIL_FORMAT_COLORSPACE_RGB ||
+       desc->block.width != 1 || desc->block.height != 1)
+      return false;
+
+   if (desc->is_array)
+      return true;
+
+   return desc->is_bitmask && !desc->is_mixed &&
+          util_is_power_of_two_or_zero(desc->block.bits) &&
+          desc->block.bits <= 32 &&
+          (desc->channel[0].type == UTIL_FORMAT_TYPE_UNSIGNED ||
+           desc->channel[1].type == UTIL_FORMAT_TYPE_UNSIGNED);
+}
+
+
+static bool
+is_supported_element(const struct translate_element *element)
+{
+   const struct util_format_description *desc;
+
+   if (element->type == TRANSLATE_ELEMENT_INSTANCE_ID) {
+      return element->output_format == PIPE_FORMAT_R32_USCALED ||
+             element->output_format == PIPE_FORMAT_R32_SSCALED ||
+             element->output_format == PIPE_FORMAT_R32_FLOAT;
+   }
+
+   if (is_copy_element(element))
+      return true;
+
+   if (!is_float32_output(element->output_format))
+      return false;
+
+   /* Pure integers are passed through as integers, which fetching into
+    * floats would not do.
+    */
+   desc = util_format_description(element->input_format);
+   return desc && !util_format_is_pure_integer(element->input_format) &&
+          has_inline_fetch(desc);
+}
+
+
+static LLVMTypeRef
+create_input_type(struct gallivm_state *gallivm)
+{
+   LLVMTypeRef elem_types[TRANSLATE_LLVM_INPUT_NUM_MEMBERS];
+   LLVMTypeRef int32_type = LLVMInt32TypeInContext(gallivm->context);
+
+   elem_types[TRANSLATE_LLVM_INPUT_PTR] =
+      LLVMPointerType(LLVMInt8TypeInContext(gallivm->context), 0);
+   elem_types[TRANSLATE_LLVM_INPUT_STRIDE] = int32_type;
+   elem_types[TRANSLATE_LLVM_INPUT_MAX_INDEX] = int32_type;
+
+   return LLVMStructTypeInContext(gallivm->context, elem_types,
+                                  ARRAY_SIZE(elem_types), 0);
+}
+
+
+static LLVMValueRef
+load_input_member(struct gallivm_state *gallivm, LLVMTypeRef input_type,
+                  LLVMValueRef inputs, unsigned attr,
+                  enum translate_llvm_member member)
+{
+   LLVMBuilderRef builder = gallivm->builder;
+   LLVMValueRef indices[2] = {
+      lp_build_const_int32(gallivm, attr),
+      lp_build_const_int32(gallivm, member),
+   };
+   LLVMValueRef ptr = LLVMBuildGEP2(builder, input_type, inputs,
+                                    indices, 2, "");
+
+   return LLVMBuildLoad2(builder, LLVMStructGetTypeAtIndex(input_type, member),
+                         ptr, "");
+}
+
+
+static void
+emit_element(struct gallivm_state *gallivm,
+             const struct translate_element *element,
+             LLVMValueRef src, LLVMValueRef dst)
+{
+   LLVMBuilderRef builder = gallivm->builder;
+   const struct util_format_description *desc =
+      util_format_description(element->input_format);
+
+   if (is_copy_element(element)) {
+      LLVMTypeRef int_type =
+         LLVMIntTypeInContext(gallivm->context, desc->block.bits);
+      LLVMValueRef value = LLVMBuildLoad2(builder, int_type, src, "");
+      LLVMSetAlignment(value, 1);
+      LLVMSetAlignment(LLVMBuildStore(builder, value, dst), 1);
+   } else {
+      LLVMTypeRef float_type = LLVMFloatTypeInContext(gallivm->context);
+      LLVMValueRef zero = lp_build_const_int32(gallivm, 0);
+      LLVMValueRef rgba =
+         lp_build_fetch_rgba_aos(gallivm, desc, lp_float32_vec4_type(),
+                                 false, src, zero, zero, zero, NULL);
+      unsigned nr_channels =
+         util_format_description(element->output_format)->nr_channels;
+
+      if (nr_channels == 4) {
+         LLVMSetAlignment(LLVMBuildStore(builder, rgba, dst), 4);
+      } else {
+         for (unsigned c = 0; c < nr_channels; c++) {
+            LLVMValueRef index = lp_build_const_int32(gallivm, c);
+            LLVMValueRef value =
+               LLVMBuildExtractElement(builder, rgba, index, "");
+            LLVMValueRef ptr =
+               LLVMBuildGEP2(builder, float_type, dst, &index, 1, "");
+            LLVMSetAlignment(LLVMBuildStore(builder, value, ptr), 4);
+         }
+      }
+   }
+}
+
+
+/**
+ * Build the loop translating "count" vertices, reading index_size-byte
+ * indices from "elts", or none if index_size is 0.
+ */
+static LLVMValueRef
+create_run_func(struct translate_llvm *tl, unsigned index_size)
+{
+   struct gallivm_state *gallivm = tl->gallivm;
+   const struct translate_key *key = &tl->translate.key;
+   LLVMContextRef context = gallivm->context;
+   LLVMBuilderRef builder = gallivm->builder;
+   LLVMTypeRef int8_type = LLVMInt8TypeInContext(context);
+   LLVMTypeRef int32_type = LLVMInt32TypeInContext(context);
+   LLVMTypeRef int64_type = LLVMInt64TypeInContext(context);
+   LLVMTypeRef input_type = create_input_type(gallivm);
+   LLVMTypeRef arg_types[7];
+   LLVMValueRef func, inputs, elts, start, count, start_instance, instance_id;
+   LLVMValueRef output, elt, vert;
+   LLVMValueRef attr_ptr[TRANSLATE_MAX_ATTRIBS];
+   LLVMValueRef attr_stride[TRANSLATE_MAX_ATTRIBS];
+   LLVMValueRef attr_max_index[TRANSLATE_MAX_ATTRIBS];
+   struct lp_build_loop_state loop;
+   char name[32];
+
+   arg_types[0] = LLVMPointerType(input_type, 0);       /* inputs */
+   arg_types[1] = LLVMPointerType(int8_type, 0);        /* elts */
+   arg_types[2] = int32_type;                           /* start */
+   arg_types[3] = int32_type;                           /* count */
+   arg_types[4] = int32_type;                           /* start_instance */
+   arg_types[5] = int32_type;                           /* instance_id */
+   arg_types[6] = LLVMPointerType(int8_type, 0);        /* output_buffer */
+
+   snprintf(name, sizeof name, "translate_run_elts%u", index_size * 8);
+   func = LLVMAddFunction(gallivm->module, name,
+                          LLVMFunctionType(LLVMVoidTypeInContext(context),
+                                           arg_types, ARRAY_SIZE(arg_types),
+                                           0));
+   LLVMSetFunctionCallConv(func, LLVMCCallConv);
+
+   inputs = LLVMGetParam(func, 0);
+   elts = LLVMGetParam(func, 1);
+   start = LLVMGetParam(func, 2);
+   count = LLVMGetParam(func, 3);
+   start_instance = LLVMGetParam(func, 4);
+   instance_id = LLVMGetParam(func, 5);
+   output = LLVMGetParam(func, 6);
+
+   LLVMPositionBuilderAtEnd(builder,
+                            LLVMAppendBasicBlockInContext(context, func,
+                                                          "entry"));
+
+   /* The inputs don't change during a run: load them once. */
+   for (unsigned i = 0; i < key->nr_elements; i++) {
+      const struct translate_element *element = &key->element[i];
+
+      if (element->type != TRANSLATE_ELEMENT_NORMAL)
+         continue;
+
+      attr_ptr[i] = load_input_member(gallivm, input_type, inputs, i,
+                                      TRANSLATE_LLVM_INPUT_PTR);
+      attr_stride[i] =
+         LLVMBuildZExt(builder,
+                       load_input_member(gallivm, input_type, inputs, i,
+                                         TRANSLATE_LLVM_INPUT_STRIDE),
+                       int64_type, "");
+      attr_max_index[i] = load_input_member(gallivm, input_type, inputs, i,
+                                            TRANSLATE_LLVM_INPUT_MAX_INDEX);
+   }
+
+   lp_build_loop_begin(&loop, gallivm, lp_build_const_int32(gallivm, 0));
+
+   if (index_size) {
+      LLVMTypeRef index_type = LLVMIntTypeInContext(context, index_size * 8);
+      LLVMValueRef ptr =
+         LLVMBuildGEP2(builder, index_type, elts, &loop.counter, 1, "");
+      elt = LLVMBuildLoad2(builder, index_type, ptr, "");
+      elt = LLVMBuildZExt(builder, elt, int32_type, "");
+   } else {
+      elt = LLVMBuildAdd(builder, start, loop.counter, "");
+   }
+
+   vert = LLVMBuildMul(builder,
+                       LLVMBuildZExt(builder, loop.counter, int64_type, ""),
+                       LLVMConstInt(int64_type, key->output_stride, 0), "");
+   vert = LLVMBuildGEP2(builder, int8_type, output, &vert, 1, "");
+
+   for (unsigned i = 0; i < key->nr_elements; i++) {
+      const struct translate_element *element = &key->element[i];
+      LLVMValueRef dst_offset =
+         lp_build_const_int32(gallivm, element->output_offset);
+      LLVMValueRef dst =
+         LLVMBuildGEP2(builder, int8_type, vert, &dst_offset, 1, "");
+      LLVMValueRef index, src;
+
+      if (element->type == TRANSLATE_ELEMENT_INSTANCE_ID) {
+         LLVMValueRef value = instance_id;
+
+         if (element->output_format == PIPE_FORMAT_R32_FLOAT) {
+            value = LLVMBuildUIToFP(builder, value,
+                                    LLVMFloatTypeInContext(context), "");
+         }
+         LLVMSetAlignment(LLVMBuildStore(builder, value, dst), 4);
+         continue;
+      }
+
+      if (element->instance_divisor) {
+         index = LLVMBuildUDiv(builder, instance_id,
+                               lp_build_const_int32(gallivm,
+                                                    element->instance_divisor),
+                               "");
+         index = LLVMBuildAdd(builder, start_instance, index, "");
+      } else if (index_size) {
+         /* clamp to avoid going out of bounds */
+         LLVMValueRef in_bounds =
+            LLVMBuildICmp(builder, LLVMIntULE, elt, attr_max_index[i], "");
+         index = LLVMBuildSelect(builder, in_bounds, elt, attr_max_index[i],
+                                 "");
+      } else {
+         index = elt;
+      }
+
+      index = LLVMBuildMul(builder,
+                           LLVMBuildZExt(builder, index, int64_type, ""),
+                           attr_stride[i], "");
+      src = LLVMBuildGEP2(builder, int8_type, attr_ptr[i], &index, 1, "");
+
+      emit_element(gallivm, element, src, dst);
+   }
+
+   lp_build_loop_end_cond(&loop, count, NULL, LLVMIntUGE);
+
+   LLVMBuildRetVoid(builder);
+
+   gallivm_verify_function(gallivm, func);
+
+   return func;
+}
+
+
+static void UTIL_CDECL
+translate_llvm_run_elts(struct translate *translate,
+                        const unsigned *elts,
+                        unsigned count,
+                        unsigned start_instance,
+                        unsigned instance_id,
+                        void *output_buffer)
+{
+   struct translate_llvm *tl = translate_llvm(translate);
+
+   if (count)
+      tl->run_func[4](tl->inputs, elts, 0, count, start_instance,
+                      instance_id, output_buffer);
+}
+
+static void UTIL_CDECL
+translate_llvm_run_elts16(struct translate *translate,
+                          const uint16_t *elts,
+                          unsigned count,
+                          unsigned start_instance,
+                          unsigned instance_id,
+                          void *output_buffer)
+{
+   struct translate_llvm *tl = translate_llvm(translate);
+
+   if (count)
+      tl->run_func[2](tl->inputs, elts, 0, count, start_instance,
+                      instance_id, output_buffer);
+}
+
+static void UTIL_CDECL
+translate_llvm_run_elts8(struct translate *translate,
+                         const uint8_t *elts,
+                         unsigned count,
+                         unsigned start_instance,
+                         unsigned instance_id,
+                         void *output_buffer)
+{
+   struct translate_llvm *tl = translate_llvm(translate);
+
+   if (count)
+      tl->run_func[1](tl->inputs, elts, 0, count, start_instance,
+                      instance_id, output_buffer);
+}
+
+static void UTIL_CDECL
+translate_llvm_run(struct translate *translate,
+                   unsigned start,
+                   unsigned count,
+                   unsigned start_instance,
+                   unsigned instance_id,
+                   void *output_buffer)
+{
+   struct translate_llvm *tl = translate_llvm(translate);
+
+   if (count)
+      tl->run_func[0](tl->inputs, NULL, start, count, start_instance,
+                      instance_id, output_buffer);
+}
+
+
+static void
+translate_llvm_set_buffer(struct translate *translate,
+                          unsigned buf,
+                          const void *ptr,
+                          unsigned stride,
+                          unsigned max_index)
+{
+   struct translate_llvm *tl = translate_llvm(translate);
+
+   for (unsigned i = 0; i < translate->key.nr_elements; i++) {
+      if (translate->key.element[i].input_buffer == buf) {
+         tl->inputs[i].ptr = (const uint8_t *)ptr +
+                             translate->key.element[i].input_offset;
+         tl->inputs[i].stride = stride;
+         tl->inputs[i].max_index = max_index;
+      }
+   }
+}
+
+
+static void
+translate_llvm_release(struct translate *translate)
+{
+   struct translate_llvm *tl = translate_llvm(translate);
+
+   gallivm_destroy(tl->gallivm);
+   LLVMContextDispose(tl->context);
+   FREE(tl);
+}
+
+
+struct translate *
+translate_llvm_create(const struct translate_key *key)
+{
+   static const unsigned index_sizes[] = { 0, 1, 2, 4 };
+   LLVMValueRef funcs[ARRAY_SIZE(index_sizes)];
+   struct translate_llvm *tl;
+
+   assert(key->nr_elements <= TRANSLATE_MAX_ATTRIBS);
+
+   for (unsigned i = 0; i < key->nr_elements; i++) {
+      if (!is_supported_element(&key->element[i]))
+         return NULL;
+   }
+
+   if (!lp_build_init())
+      return NULL;
+
+   tl = CALLOC_STRUCT(translate_llvm);
+   if (!tl)
+      return NULL;
+
+   tl->translate.key = *key;
+   tl->translate.release = translate_llvm_release;
+   tl->translate.set_buffer = translate_llvm_set_buffer;
+   tl->translate.run_elts = translate_llvm_run_elts;
+   tl->translate.run_elts16 = translate_llvm_run_elts16;
+   tl->translate.run_elts8 = translate_llvm_run_elts8;
+   tl->translate.run = translate_llvm_run;
+
+   tl->context = LLVMContextCreate();
+   if (!tl->context)
+      goto fail;
+
+#if LLVM_VERSION_MAJOR == 15
+   LLVMContextSetOpaquePointers(tl->context, false);
+#endif
+
+   tl->gallivm = gallivm_create("translate", tl->context, NULL);
+   if (!tl->gallivm)
+      goto fail;
+
+   for (unsigned i = 0; i < ARRAY_SIZE(index_sizes); i++)
+      funcs[i] = create_run_func(tl, index_sizes[i]);
+
+   gallivm_compile_module(tl->gallivm);
+
+   for (unsigned i = 0; i < ARRAY_SIZE(index_sizes); i++) {
+      tl->run_func[index_sizes[i]] = (translate_llvm_run_func)
+         gallivm_jit_function(tl->gallivm, funcs[i]);
+   }
+
+   gallivm_free_ir(tl->gallivm);
+
+   return &tl->translate;
+
+fail:
+   if (tl->context)
+      LLVMContextDispose(tl->context);
+   FREE(tl);
+   return NULL;
+}
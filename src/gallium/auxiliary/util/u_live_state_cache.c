@@ -0,0 +1,206 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "util/u_live_state_cache.h"
+
+#include "util/hash_table.h"
+#include "util/u_memory.h"
+
+struct util_live_state_key {
+   enum util_live_state_type type;
+   unsigned size;
+   const void *data;
+};
+
+struct util_live_state {
+   struct util_live_state_key key;
+   void *cso;
+   unsigned refcount; /* protected by the cache lock */
+   /* followed by the template, which key.data points to */
+};
+
+static uint32_t
+key_hash(const void *key)
+{
+   const struct util_live_state_key *k = key;
+
+   return _mesa_hash_data_with_seed(k->data, k->size, k->type);
+}
+
+static bool
+key_equals(const void *a, const void *b)
+{
+   const struct util_live_state_key *ka = a, *kb = b;
+
+   return ka->type == kb->type && ka->size == kb->size &&
+          !memcmp(ka->data, kb->data, ka->size);
+}
+
+void
+util_live_state_cache_init(struct util_live_state_cache *cache,
+                           void *(*create_sampler_state)(struct pipe_context *,
+                                                         const struct pipe_sampler_state *),
+                           void (*delete_sampler_state)(struct pipe_context *, void *),
+                           void *(*create_vertex_elements_state)(struct pipe_context *, unsigned,
+                                                                 const struct pipe_vertex_element *),
+                           void (*delete_vertex_elements_state)(struct pipe_context *, void *))
+{
+   simple_mtx_init(&cache->lock, mtx_plain);
+   cache->states = _mesa_hash_table_create(NULL, key_hash, key_equals);
+   cache->csos = _mesa_pointer_hash_table_create(NULL);
+   cache->create_sampler_state = create_sampler_state;
+   cache->delete_sampler_state = delete_sampler_state;
+   cache->create_vertex_elements_state = create_vertex_elements_state;
+   cache->delete_vertex_elements_state = delete_vertex_elements_state;
+}
+
+void
+util_live_state_cache_deinit(struct util_live_state_cache *cache)
+{
+   if (cache->states) {
+      /* The hash tables should be empty at this point. */
+      _mesa_hash_table_destroy(cache->states, NULL);
+      _mesa_hash_table_destroy(cache->csos, NULL);
+      simple_mtx_destroy(&cache->lock);
+   }
+}
+
+static void
+delete_cso(struct pipe_context *ctx, struct util_live_state_cache *cache,
+           enum util_live_state_type type, void *cso)
+{
+   if (type == UTIL_LIVE_STATE_SAMPLER)
+      cache->delete_sampler_state(ctx, cso);
+   else
+      cache->delete_vertex_elements_state(ctx, cso);
+}
+
+static void *
+live_state_get(struct pipe_context *ctx, struct util_live_state_cache *cache,
+               enum util_live_state_type type, const void *data, unsigned size)
+{
+   struct util_live_state_key key = {type, size, data};
+   struct util_live_state *state, *state2;
+   struct hash_entry *entry;
+   void *cso;
+
+   /* Find the state in the live cache. */
+   simple_mtx_lock(&cache->lock);
+   entry = _mesa_hash_table_search(cache->states, &key);
+   state = entry ? entry->data : NULL;
+
+   /* Increase the refcount. */
+   if (state) {
+      state->refcount++;
+      cache->hits[type]++;
+      cso = state->cso;
+   }
+   simple_mtx_unlock(&cache->lock);
+
+   if (state)
+      return cso;
+
+   /* The cache mutex is unlocked to allow multiple contexts to create
+    * states simultaneously.
+    */
+   if (type == UTIL_LIVE_STATE_SAMPLER) {
+      cso = cache->create_sampler_state(ctx, data);
+   } else {
+      cso = cache->create_vertex_elements_state(
+         ctx, size / sizeof(struct pipe_vertex_element), data);
+   }
+   if (!cso)
+      return NULL;
+
+   state = MALLOC(sizeof(*state) + size);
+   if (!state) {
+      delete_cso(ctx, cache, type, cso);
+      return NULL;
+   }
+
+   if (size)
+      memcpy(state + 1, data, size);
+   state->key.type = type;
+   state->key.size = size;
+   state->key.data = state + 1;
+   state->cso = cso;
+   state->refcount = 1;
+
+   simple_mtx_lock(&cache->lock);
+   /* The same state might have been created in parallel. This is rare.
+    * If so, keep the one already in cache.
+    */
+   entry = _mesa_hash_table_search(cache->states, &key);
+   state2 = entry ? entry->data : NULL;
+
+   if (state2) {
+      state2->refcount++;
+      cso = state2->cso;
+   } else {
+      _mesa_hash_table_insert(cache->states, &state->key, state);
+      _mesa_hash_table_insert(cache->csos, cso, state);
+   }
+   cache->misses[type]++;
+   simple_mtx_unlock(&cache->lock);
+
+   if (state2) {
+      delete_cso(ctx, cache, type, state->cso);
+      FREE(state);
+   }
+
+   return cso;
+}
+
+void *
+util_live_sampler_state_get(struct pipe_context *ctx,
+                            struct util_live_state_cache *cache,
+                            const struct pipe_sampler_state *state)
+{
+   return live_state_get(ctx, cache, UTIL_LIVE_STATE_SAMPLER, state,
+                         sizeof(*state));
+}
+
+void *
+util_live_vertex_elements_state_get(struct pipe_context *ctx,
+                                    struct util_live_state_cache *cache,
+                                    unsigned count,
+                                    const struct pipe_vertex_element *elements)
+{
+   return live_state_get(ctx, cache, UTIL_LIVE_STATE_VERTEX_ELEMENTS,
+                         elements, count * sizeof(*elements));
+}
+
+bool
+util_live_state_release(struct pipe_context *ctx,
+                        struct util_live_state_cache *cache,
+                        void *cso)
+{
+   struct util_live_state *state;
+   struct hash_entry *entry;
+   bool destroy = false;
+
+   simple_mtx_lock(&cache->lock);
+   entry = _mesa_hash_table_search(cache->csos, cso);
+   if (!entry) {
+      simple_mtx_unlock(&cache->lock);
+      return false;
+   }
+
+   state = entry->data;
+
+   if (--state->refcount == 0) {
+      _mesa_hash_table_remove(cache->csos, entry);
+      _mesa_hash_table_remove_key(cache->states, &state->key);
+      destroy = true;
+   }
+   simple_mtx_unlock(&cache->lock);
+
+   if (destroy) {
+      delete_cso(ctx, cache, state->key.type, cso);
+      FREE(state);
+   }
+
+   return true;
+}
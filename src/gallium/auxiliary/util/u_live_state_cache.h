@@ -0,0 +1,99 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/* This deduplicates live state CSOs across contexts, meaning that creating
+ * 2 sampler states with the same template in 2 contexts returns the same
+ * CSO. This is the state counterpart of u_live_shader_cache.
+ *
+ * The per-context cso_cache already deduplicates states within a context.
+ * This is for applications creating identical states in many contexts.
+ *
+ * How to use this:
+ *
+ * - Driver states must not depend on the context that created them,
+ *   because any context can use and delete them.
+ *
+ * - Declare struct util_live_state_cache in your pipe_screen and initialize
+ *   it with util_live_state_cache_init, passing your driver versions of
+ *   create_xx_state and delete_xx_state.
+ *
+ * - create_xx_state should only call util_live_sampler_state_get or
+ *   util_live_vertex_elements_state_get.
+ *
+ * - delete_xx_state should only call util_live_state_release. This will
+ *   decrease the reference count.
+ *
+ * - Call util_live_state_cache_deinit when you destroy your screen.
+ */
+
+#ifndef U_LIVE_STATE_CACHE_H
+#define U_LIVE_STATE_CACHE_H
+
+#include "util/simple_mtx.h"
+#include "pipe/p_state.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum util_live_state_type {
+   UTIL_LIVE_STATE_SAMPLER,
+   UTIL_LIVE_STATE_VERTEX_ELEMENTS,
+   UTIL_LIVE_STATE_COUNT,
+};
+
+struct util_live_state_cache {
+   simple_mtx_t lock;
+   struct hash_table *states;   /* template -> util_live_state */
+   struct hash_table *csos;     /* driver CSO -> util_live_state */
+
+   void *(*create_sampler_state)(struct pipe_context *,
+                                 const struct pipe_sampler_state *);
+   void (*delete_sampler_state)(struct pipe_context *, void *);
+   void *(*create_vertex_elements_state)(struct pipe_context *, unsigned,
+                                         const struct pipe_vertex_element *);
+   void (*delete_vertex_elements_state)(struct pipe_context *, void *);
+
+   unsigned hits[UTIL_LIVE_STATE_COUNT];
+   unsigned misses[UTIL_LIVE_STATE_COUNT];
+};
+
+void
+util_live_state_cache_init(struct util_live_state_cache *cache,
+                           void *(*create_sampler_state)(struct pipe_context *,
+                                                         const struct pipe_sampler_state *),
+                           void (*delete_sampler_state)(struct pipe_context *, void *),
+                           void *(*create_vertex_elements_state)(struct pipe_context *, unsigned,
+                                                                 const struct pipe_vertex_element *),
+                           void (*delete_vertex_elements_state)(struct pipe_context *, void *));
+
+void
+util_live_state_cache_deinit(struct util_live_state_cache *cache);
+
+void *
+util_live_sampler_state_get(struct pipe_context *ctx,
+                            struct util_live_state_cache *cache,
+                            const struct pipe_sampler_state *state);
+
+void *
+util_live_vertex_elements_state_get(struct pipe_context *ctx,
+                                    struct util_live_state_cache *cache,
+                                    unsigned count,
+                                    const struct pipe_vertex_element *elements);
+
+/* Drop a reference to a CSO returned by the functions above, and delete it
+ * with the driver callback if it was the last one. Returns false if the CSO
+ * doesn't come from the cache, in which case nothing is done.
+ */
+bool
+util_live_state_release(struct pipe_context *ctx,
+                        struct util_live_state_cache *cache,
+                        void *cso);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "util/u_live_state_cache.h"
+#include "util/u_memory.h"
+
+/* A fake driver that counts its calls. Both state types are allocated with
+ * MALLOC, so one delete callback works for both.
+ */
+static unsigned num_created;
+static unsigned num_deleted;
+static void *last_deleted;
+
+/* Set by the concurrency test: create_sampler_state then waits until this
+ * many threads are inside it, so that they all miss the cache together.
+ */
+static std::mutex create_mutex;
+static std::condition_variable create_cond;
+static unsigned create_barrier;
+static unsigned num_creating;
+
+static void *
+create_sampler_state(struct pipe_context *ctx,
+                     const struct pipe_sampler_state *state)
+{
+   std::unique_lock<std::mutex> lock(create_mutex);
+
+   num_created++;
+   if (create_barrier) {
+      num_creating++;
+      create_cond.notify_all();
+      create_cond.wait(lock, [] { return num_creating >= create_barrier; });
+   }
+   return mem_dup(state, sizeof(*state));
+}
+
+static void *
+create_vertex_elements_state(struct pipe_context *ctx, unsigned count,
+                             const struct pipe_vertex_element *elements)
+{
+   std::lock_guard<std::mutex> lock(create_mutex);
+
+   num_created++;
+   return MALLOC(sizeof(*elements) * count + 1);
+}
+
+static void
+delete_state(struct pipe_context *ctx, void *state)
+{
+   std::lock_guard<std::mutex> lock(create_mutex);
+
+   num_deleted++;
+   last_deleted = state;
+   FREE(state);
+}
+
+class live_state_cache : public ::testing::Test {
+protected:
+   void SetUp() override
+   {
+      num_created = 0;
+      num_deleted = 0;
+      last_deleted = NULL;
+      create_barrier = 0;
+      num_creating = 0;
+      util_live_state_cache_init(&cache, create_sampler_state, delete_state,
+                                 create_vertex_elements_state, delete_state);
+   }
+
+   void TearDown() override
+   {
+      util_live_state_cache_deinit(&cache);
+   }
+
+   struct util_live_state_cache cache = {};
+};
+
+TEST_F(live_state_cache, refcount)
+{
+   struct pipe_sampler_state templ = {};
+   templ.wrap_s = PIPE_TEX_WRAP_CLAMP_TO_EDGE;
+
+   void *a = util_live_sampler_state_get(NULL, &cache, &templ);
+   void *b = util_live_sampler_state_get(NULL, &cache, &templ);
+   ASSERT_NE(a, nullptr);
+   EXPECT_EQ(a, b);
+   EXPECT_EQ(num_created, 1u);
+   EXPECT_EQ(cache.misses[UTIL_LIVE_STATE_SAMPLER], 1u);
+   EXPECT_EQ(cache.hits[UTIL_LIVE_STATE_SAMPLER], 1u);
+
+   /* The CSO is only deleted when the last reference is dropped. */
+   EXPECT_TRUE(util_live_state_release(NULL, &cache, a));
+   EXPECT_EQ(num_deleted, 0u);
+   EXPECT_TRUE(util_live_state_release(NULL, &cache, b));
+   EXPECT_EQ(num_deleted, 1u);
+   EXPECT_EQ(last_deleted, a);
+
+   /* Once deleted, the same template creates a new CSO. */
+   void *c = util_live_sampler_state_get(NULL, &cache, &templ);
+   EXPECT_EQ(num_created, 2u);
+   EXPECT_EQ(cache.misses[UTIL_LIVE_STATE_SAMPLER], 2u);
+   EXPECT_TRUE(util_live_state_release(NULL, &cache, c));
+   EXPECT_EQ(num_deleted, 2u);
+}
+
+TEST_F(live_state_cache, different_keys)
+{
+   struct pipe_sampler_state templ_a = {};
+   struct pipe_sampler_state templ_b = {};
+   templ_b.wrap_s = PIPE_TEX_WRAP_MIRROR_REPEAT;
+
+   struct pipe_vertex_element elements[2] = {};
+   elements[0].src_format = PIPE_FORMAT_R32G32B32A32_FLOAT;
+   elements[1].src_format = PIPE_FORMAT_R32G32B32A32_FLOAT;
+
+   void *sampler_a = util_live_sampler_state_get(NULL, &cache, &templ_a);
+   void *sampler_b = util_live_sampler_state_get(NULL, &cache, &templ_b);
+   void *velems_1 = util_live_vertex_elements_state_get(NULL, &cache, 1, elements);
+   void *velems_2 = util_live_vertex_elements_state_get(NULL, &cache, 2, elements);
+   void *velems_2b = util_live_vertex_elements_state_get(NULL, &cache, 2, elements);
+
+   EXPECT_NE(sampler_a, sampler_b);
+   EXPECT_NE(velems_1, velems_2);
+   EXPECT_EQ(velems_2, velems_2b);
+   EXPECT_EQ(num_created, 4u);
+   EXPECT_EQ(cache.hits[UTIL_LIVE_STATE_VERTEX_ELEMENTS], 1u);
+
+   for (void *cso : {sampler_a, sampler_b, velems_1, velems_2, velems_2b})
+      EXPECT_TRUE(util_live_state_release(NULL, &cache, cso));
+   EXPECT_EQ(num_deleted, 4u);
+}
+
+TEST_F(live_state_cache, concurrent_insert)
+{
+   struct pipe_sampler_state templ = {};
+   void *csos[2];
+
+   /* Both threads miss the cache and create a CSO, and only one of them may
+    * be inserted. The other thread must get the cached CSO, and its own
+    * duplicate must be deleted.
+    */
+   create_barrier = 2;
+   std::thread threads[2];
+   for (unsigned i = 0; i < 2; i++) {
+      threads[i] = std::thread([&, i] {
+         csos[i] = util_live_sampler_state_get(NULL, &cache, &templ);
+      });
+   }
+   for (std::thread &t : threads)
+      t.join();
+
+   ASSERT_NE(csos[0], nullptr);
+   EXPECT_EQ(csos[0], csos[1]);
+   EXPECT_EQ(num_created, 2u);
+   EXPECT_EQ(num_deleted, 1u);
+   EXPECT_NE(last_deleted, csos[0]);
+   EXPECT_EQ(cache.misses[UTIL_LIVE_STATE_SAMPLER], 2u);
+
+   /* The cached CSO holds a reference for each thread. */
+   EXPECT_TRUE(util_live_state_release(NULL, &cache, csos[0]));
+   EXPECT_EQ(num_deleted, 1u);
+   EXPECT_TRUE(util_live_state_release(NULL, &cache, csos[1]));
+   EXPECT_EQ(num_deleted, 2u);
+   EXPECT_EQ(last_deleted, csos[0]);
+}
+
+TEST_F(live_state_cache, release_uncached)
+{
+   struct pipe_sampler_state templ = {};
+   void *cso = util_live_sampler_state_get(NULL, &cache, &templ);
+   int not_a_cso;
+
+   /* Unknown CSOs are left alone, and don't affect cached ones. */
+   EXPECT_FALSE(util_live_state_release(NULL, &cache, &not_a_cso));
+   EXPECT_FALSE(util_live_state_release(NULL, &cache, &templ));
+   EXPECT_EQ(num_deleted, 0u);
+
+   EXPECT_TRUE(util_live_state_release(NULL, &cache, cso));
+   EXPECT_EQ(num_deleted, 1u);
+
+   /* Neither are CSOs that have already been deleted. */
+   EXPECT_FALSE(util_live_state_release(NULL, &cache, cso));
+   EXPECT_EQ(num_deleted, 1u);
+}
@@ -30,6 +30,8 @@
 #include "util/u_inlines.h"
 #include "util/u_memory.h"
 #include "util/u_upload_mgr.h"
+#include "util/os_time.h"
+#include "util/u_vbuf.h"
 #include "driver_trace/tr_context.h"
 #include "util/log.h"
 #include "util/perf/cpu_trace.h"
@@ -476,6 +478,38 @@ batch_execute(struct tc_batch *batch, struct pipe_context *pipe, uint64_t *last,
    }
 }
 
+/* A draw whose index bounds are computed before the batch is executed. */
+struct tc_index_bounds {
+   struct pipe_draw_info *info; /* points into the batch */
+   const void *indices;
+   unsigned count;
+};
+
+/* Side-effect-free work on a flushed batch that doesn't have to be done by
+ * the driver thread. This runs in a preprocessing thread, possibly in
+ * parallel with the execution of earlier batches, and always finishes before
+ * the batch is executed.
+ */
+static void
+tc_batch_preprocess(void *job, UNUSED void *gdata, UNUSED int thread_index)
+{
+   struct tc_batch *batch = job;
+
+   /* The indices are in the mapped upload buffer, which is only unmapped by
+    * a buffer_unmap call in this or a later batch.
+    */
+   util_dynarray_foreach(&batch->index_bounds, struct tc_index_bounds, b) {
+      unsigned min_index, max_index;
+
+      u_vbuf_get_minmax_index_mapped(b->info, b->count, b->indices,
+                                     &min_index, &max_index);
+      b->info->min_index = min_index;
+      b->info->max_index = max_index;
+      b->info->index_bounds_valid = true;
+   }
+   util_dynarray_clear(&batch->index_bounds);
+}
+
 static void
 tc_batch_execute(void *job, UNUSED void *gdata, int thread_index)
 {
@@ -486,6 +520,14 @@ tc_batch_execute(void *job, UNUSED void *gdata, int thread_index)
    tc_batch_check(batch);
    tc_set_driver_thread(batch->tc);
 
+   if (batch->tc->options.num_preprocess_threads) {
+      util_queue_fence_wait(&batch->preprocess_fence);
+
+      /* Batches executed by tc_sync are not preprocessed in advance. */
+      if (batch->index_bounds.size)
+         tc_batch_preprocess(batch, NULL, 0);
+   }
+
    assert(!batch->token);
 
    /* setup renderpass info */
@@ -567,6 +609,33 @@ tc_add_call_end(struct tc_batch *next)
    call->num_slots = 1;
 }
 
+/* Adapt the batch size to the load of the driver thread and to how often
+ * the application waits for it.
+ */
+static void
+tc_update_batch_slots_limit(struct threaded_context *tc)
+{
+   unsigned limit = tc->batch_slots_limit;
+   unsigned num_syncs = p_atomic_read(&tc->num_syncs);
+
+   /* If the driver thread has already executed the previous batch, it's
+    * idle and waiting for this one, so flush earlier next time. The same
+    * goes for applications that called something that syncs (e.g. a map or
+    * a query readback) since the last flush, because every sync waits for
+    * all queued calls and smaller batches let the driver thread start on
+    * them sooner. Otherwise, the driver thread still has work queued and
+    * larger batches reduce the overhead.
+    */
+   if (util_queue_fence_is_signalled(&tc->batch_slots[tc->last].fence) ||
+       num_syncs != tc->batch_slots_limit_num_syncs)
+      limit = MAX2(limit / 2, TC_MIN_SLOTS_PER_BATCH);
+   else
+      limit = MIN2(limit + limit / 4, TC_SLOTS_PER_BATCH);
+
+   tc->batch_slots_limit = limit;
+   tc->batch_slots_limit_num_syncs = num_syncs;
+}
+
 static void
 tc_batch_flush(struct threaded_context *tc, bool full_copy)
 {
@@ -580,6 +649,10 @@ tc_batch_flush(struct threaded_context *tc, bool full_copy)
    tc_debug_check(tc);
    tc->bytes_mapped_estimate = 0;
    p_atomic_add(&tc->num_offloaded_slots, next->num_total_slots);
+   p_atomic_inc(&tc->num_batches);
+
+   if (tc->options.adaptive_batch_size)
+      tc_update_batch_slots_limit(tc);
 
    if (next->token) {
       next->token->tc = NULL;
@@ -596,6 +669,11 @@ tc_batch_flush(struct threaded_context *tc, bool full_copy)
       tc_batch_increment_renderpass_info(tc, next_id, full_copy);
    }
 
+   if (next->index_bounds.size) {
+      util_queue_add_job(&tc->preprocess_queue, next, &next->preprocess_fence,
+                         tc_batch_preprocess, NULL, 0);
+   }
+
    util_queue_add_job(&tc->queue, next, &next->fence, tc_batch_execute,
                       NULL, 0);
    tc->last = tc->next;
@@ -619,7 +697,8 @@ tc_add_sized_call(struct threaded_context *tc, enum tc_call_id id,
    assert(num_slots <= TC_SLOTS_PER_BATCH - 1);
    tc_debug_check(tc);
 
-   if (unlikely(next->num_total_slots + num_slots > TC_SLOTS_PER_BATCH - 1)) {
+   if (unlikely(next->num_total_slots + num_slots > tc->batch_slots_limit - 1 &&
+                next->num_total_slots)) {
       /* copy existing renderpass info during flush */
       tc_batch_flush(tc, true);
       next = &tc->batch_slots[tc->next];
@@ -685,7 +764,7 @@ tc_enlarge_last_mergeable_call(struct threaded_context *tc, unsigned desired_num
 
    unsigned added_slots = desired_num_slots - call->num_slots;
 
-   if (unlikely(batch->num_total_slots + added_slots > TC_SLOTS_PER_BATCH - 1))
+   if (unlikely(batch->num_total_slots + added_slots > tc->batch_slots_limit - 1))
       return false;
 
    batch->num_total_slots += added_slots;
@@ -740,7 +819,10 @@ _tc_sync(struct threaded_context *tc, UNUSED const char *info, UNUSED const char
 
    /* Only wait for queued calls... */
    if (!util_queue_fence_is_signalled(&last->fence)) {
+      int64_t start = os_time_get_nano();
+
       util_queue_fence_wait(&last->fence);
+      p_atomic_add(&tc->sync_stall_time, os_time_get_nano() - start);
       synced = true;
    }
 
@@ -1065,6 +1147,14 @@ tc_is_buffer_busy(struct threaded_context *tc, struct threaded_resource *tbuf,
    return tc->options.is_resource_busy(tc->pipe->screen, tbuf->latest, map_usage);
 }
 
+/* u_upload_mgr callback for recycling tc's upload buffers. */
+static bool
+tc_is_upload_buffer_busy(void *data, struct pipe_resource *resource)
+{
+   return tc_is_buffer_busy((struct threaded_context *)data,
+                            threaded_resource(resource), PIPE_MAP_WRITE);
+}
+
 /**
  * allow_cpu_storage should be false for user memory and imported buffers.
  */
@@ -3837,8 +3927,8 @@ tc_call_draw_multi(struct pipe_context *pipe, void *call)
 {
    struct tc_draw_multi *info = (struct tc_draw_multi*)call;
 
+   /* index_bounds_valid is only set by tc_batch_preprocess. */
    info->info.has_user_indices = false;
-   info->info.index_bounds_valid = false;
    info->info.take_index_buffer_ownership = false;
 
    pipe->draw_vbo(pipe, &info->info, 0, NULL, info->slot, info->num_draws);
@@ -3907,6 +3997,14 @@ tc_draw_single_draw_id(struct pipe_context *_pipe,
    simplify_draw_info(&p->info);
 }
 
+static void
+tc_draw_user_indices_multi(struct pipe_context *_pipe,
+                           const struct pipe_draw_info *info,
+                           unsigned drawid_offset,
+                           const struct pipe_draw_indirect_info *indirect,
+                           const struct pipe_draw_start_count_bias *draws,
+                           unsigned num_draws);
+
 /* Single draw with user indices and drawid_offset == 0. */
 static void
 tc_draw_user_indices_single(struct pipe_context *_pipe,
@@ -3925,6 +4023,14 @@ tc_draw_user_indices_single(struct pipe_context *_pipe,
    if (!size)
       return;
 
+   /* Single draws have no room for index bounds, but multi draws do. */
+   if (tc->options.num_preprocess_threads &&
+       draws[0].count >= TC_PREPROCESS_MIN_INDEX_COUNT) {
+      tc_draw_user_indices_multi(_pipe, info, drawid_offset, indirect,
+                                 draws, num_draws);
+      return;
+   }
+
    /* This must be done before adding draw_vbo, because it could generate
     * e.g. transfer_unmap and flush partially-uninitialized draw_vbo
     * to the driver if it was done afterwards.
@@ -3935,6 +4041,8 @@ tc_draw_user_indices_single(struct pipe_context *_pipe,
    if (unlikely(!buffer))
       return;
 
+   tc_add_to_buffer_list(&tc->buffer_lists[tc->next_buf_list], buffer);
+
    struct tc_draw_single *p =
       tc_add_call(tc, TC_CALL_draw_single, tc_draw_single);
    memcpy(&p->info, info, DRAW_INFO_SIZE_WITHOUT_INDEXBUF_AND_MIN_MAX_INDEX);
@@ -3974,6 +4082,8 @@ tc_draw_user_indices_single_draw_id(struct pipe_context *_pipe,
    if (unlikely(!buffer))
       return;
 
+   tc_add_to_buffer_list(&tc->buffer_lists[tc->next_buf_list], buffer);
+
    struct tc_draw_single *p =
       &tc_add_call(tc, TC_CALL_draw_single_drawid, tc_draw_single_drawid)->base;
    memcpy(&p->info, info, DRAW_INFO_SIZE_WITHOUT_INDEXBUF_AND_MIN_MAX_INDEX);
@@ -4007,10 +4117,10 @@ tc_draw_multi(struct pipe_context *_pipe, const struct pipe_draw_info *info,
    while (num_draws) {
       struct tc_batch *next = &tc->batch_slots[tc->next];
 
-      int nb_slots_left = TC_SLOTS_PER_BATCH - 1 - next->num_total_slots;
+      int nb_slots_left = tc->batch_slots_limit - 1 - next->num_total_slots;
       /* If there isn't enough place for one draw, try to fill the next one */
       if (nb_slots_left < SLOTS_FOR_ONE_DRAW)
-         nb_slots_left = TC_SLOTS_PER_BATCH - 1;
+         nb_slots_left = tc->batch_slots_limit - 1;
       const int size_left_bytes = nb_slots_left * sizeof(struct tc_call_base);
 
       /* How many draws can we fit in the current batch */
@@ -4030,6 +4140,7 @@ tc_draw_multi(struct pipe_context *_pipe, const struct pipe_draw_info *info,
       }
       take_index_buffer_ownership = false;
       memcpy(&p->info, info, DRAW_INFO_SIZE_WITHOUT_MIN_MAX_INDEX);
+      p->info.index_bounds_valid = false;
       p->num_draws = dr;
       memcpy(p->slot, &draws[total_offset], sizeof(draws[0]) * dr);
       num_draws -= dr;
@@ -4071,15 +4182,17 @@ tc_draw_user_indices_multi(struct pipe_context *_pipe,
    if (unlikely(!buffer))
       return;
 
+   tc_add_to_buffer_list(&tc->buffer_lists[tc->next_buf_list], buffer);
+
    int total_offset = 0;
    unsigned offset = 0;
    while (num_draws) {
       struct tc_batch *next = &tc->batch_slots[tc->next];
 
-      int nb_slots_left = TC_SLOTS_PER_BATCH - 1 - next->num_total_slots;
+      int nb_slots_left = tc->batch_slots_limit - 1 - next->num_total_slots;
       /* If there isn't enough place for one draw, try to fill the next one */
       if (nb_slots_left < SLOTS_FOR_ONE_DRAW)
-         nb_slots_left = TC_SLOTS_PER_BATCH - 1;
+         nb_slots_left = tc->batch_slots_limit - 1;
       const int size_left_bytes = nb_slots_left * sizeof(struct tc_call_base);
 
       /* How many draws can we fit in the current batch */
@@ -4090,6 +4203,7 @@ tc_draw_user_indices_multi(struct pipe_context *_pipe,
          tc_add_slot_based_call(tc, TC_CALL_draw_multi, tc_draw_multi,
                                 dr);
       memcpy(&p->info, info, DRAW_INFO_SIZE_WITHOUT_INDEXBUF_AND_MIN_MAX_INDEX);
+      p->info.index_bounds_valid = false;
 
       if (total_offset == 0)
          /* the first slot inherits the reference from u_upload_alloc() */
@@ -4100,6 +4214,8 @@ tc_draw_user_indices_multi(struct pipe_context *_pipe,
 
       p->num_draws = dr;
 
+      unsigned first_offset = offset;
+
       /* Upload index buffers. */
       for (unsigned i = 0; i < dr; i++) {
          unsigned count = draws[i + total_offset].count;
@@ -4121,6 +4237,19 @@ tc_draw_user_indices_multi(struct pipe_context *_pipe,
          offset += size;
       }
 
+      /* The indices of all draws in this call are contiguous, so let
+       * preprocessing compute their bounds.
+       */
+      if (tc->options.num_preprocess_threads && offset > first_offset) {
+         struct tc_index_bounds bounds = {
+            .info = &p->info,
+            .indices = ptr + first_offset,
+            .count = (offset - first_offset) >> index_size_shift,
+         };
+         util_dynarray_append(&tc->batch_slots[tc->next].index_bounds,
+                              struct tc_index_bounds, bounds);
+      }
+
       total_offset += dr;
       num_draws -= dr;
    }
@@ -4371,10 +4500,10 @@ tc_draw_vertex_state(struct pipe_context *_pipe,
    while (num_draws) {
       struct tc_batch *next = &tc->batch_slots[tc->next];
 
-      int nb_slots_left = TC_SLOTS_PER_BATCH - 1 - next->num_total_slots;
+      int nb_slots_left = tc->batch_slots_limit - 1 - next->num_total_slots;
       /* If there isn't enough place for one draw, try to fill the next one */
       if (nb_slots_left < slots_for_one_draw)
-         nb_slots_left = TC_SLOTS_PER_BATCH - 1;
+         nb_slots_left = tc->batch_slots_limit - 1;
       const int size_left_bytes = nb_slots_left * sizeof(struct tc_call_base);
 
       /* How many draws can we fit in the current batch */
@@ -5096,9 +5225,14 @@ tc_destroy(struct pipe_context *_pipe)
    if (util_queue_is_initialized(&tc->queue)) {
       util_queue_destroy(&tc->queue);
 
+      if (util_queue_is_initialized(&tc->preprocess_queue))
+         util_queue_destroy(&tc->preprocess_queue);
+
       for (unsigned i = 0; i < TC_MAX_BATCHES; i++) {
          util_queue_fence_destroy(&tc->batch_slots[i].fence);
+         util_queue_fence_destroy(&tc->batch_slots[i].preprocess_fence);
          util_dynarray_fini(&tc->batch_slots[i].renderpass_infos);
+         util_dynarray_fini(&tc->batch_slots[i].index_bounds);
          assert(!tc->batch_slots[i].token);
       }
    }
@@ -5200,8 +5334,24 @@ threaded_context_create(struct pipe_context *pipe,
    if (!tc->base.stream_uploader || !tc->base.const_uploader)
       goto fail;
 
+   /* Recycle the upload buffers instead of creating new ones when they fill
+    * up. This needs the driver's busy query for submitted work, and the
+    * buffer lists for work that hasn't been flushed yet.
+    */
+   if (tc->options.is_resource_busy) {
+      u_upload_enable_recycling(tc->base.stream_uploader,
+                                tc_is_upload_buffer_busy, tc);
+      u_upload_enable_recycling(tc->base.const_uploader,
+                                tc_is_upload_buffer_busy, tc);
+   }
+
    tc->use_forced_staging_uploads = true;
 
+   tc->options.adaptive_batch_size =
+      debug_get_bool_option("GALLIUM_THREAD_ADAPTIVE_BATCHES",
+                            tc->options.adaptive_batch_size);
+   tc->batch_slots_limit = TC_SLOTS_PER_BATCH;
+
    /* The queue size is the number of batches "waiting". Batches are removed
     * from the queue before being executed, so keep one tc_batch slot for that
     * execution. Also, keep one unused slot for an unflushed batch.
@@ -5209,6 +5359,14 @@ threaded_context_create(struct pipe_context *pipe,
    if (!util_queue_init(&tc->queue, "gdrv", TC_MAX_BATCHES - 2, 1, 0, NULL))
       goto fail;
 
+   tc->options.num_preprocess_threads =
+      debug_get_num_option("GALLIUM_THREAD_PREPROCESS",
+                           tc->options.num_preprocess_threads);
+   if (tc->options.num_preprocess_threads &&
+       !util_queue_init(&tc->preprocess_queue, "gdrvpre", TC_MAX_BATCHES - 2,
+                        tc->options.num_preprocess_threads, 0, NULL))
+      tc->options.num_preprocess_threads = 0;
+
    tc->last_completed = -1;
    for (unsigned i = 0; i < TC_MAX_BATCHES; i++) {
 #if !defined(NDEBUG) && TC_DEBUG >= 1
@@ -5217,6 +5375,8 @@ threaded_context_create(struct pipe_context *pipe,
       tc->batch_slots[i].tc = tc;
       tc->batch_slots[i].batch_idx = i;
       util_queue_fence_init(&tc->batch_slots[i].fence);
+      util_queue_fence_init(&tc->batch_slots[i].preprocess_fence);
+      util_dynarray_init(&tc->batch_slots[i].index_bounds, NULL);
       tc->batch_slots[i].renderpass_info_idx = -1;
       if (tc->options.parse_renderpass_info) {
          util_dynarray_init(&tc->batch_slots[i].renderpass_infos, NULL);
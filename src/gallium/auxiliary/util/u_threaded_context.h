@@ -250,6 +250,18 @@ struct tc_unflushed_batch_token;
  */
 #define TC_SLOTS_PER_BATCH    1536
 
+/* The smallest batch size that threaded_context_options::adaptive_batch_size
+ * can choose. It must fit a multi draw with at least one draw.
+ */
+#define TC_MIN_SLOTS_PER_BATCH 192
+
+/* Single draws with user indices only get their index bounds computed by
+ * threaded_context_options::num_preprocess_threads if they have at least
+ * this many indices. Smaller draws stay single draws, which tc can merge with
+ * neighbouring single draws, and scanning their indices is cheap anyway.
+ */
+#define TC_PREPROCESS_MIN_INDEX_COUNT 1024
+
 /* The buffer list queue is much deeper than the batch queue because buffer
  * lists need to stay around until the driver internally flushes its command
  * buffer.
@@ -522,12 +534,16 @@ struct tc_batch {
    struct tc_call_base *last_mergeable_call;
 
    struct util_queue_fence fence;
+   /* Signalled when the preprocessing of this batch has finished. */
+   struct util_queue_fence preprocess_fence;
    /* whether the first set_framebuffer_state call has been seen by this batch */
    bool first_set_fb;
    uint8_t batch_idx;
    struct tc_unflushed_batch_token *token;
    uint64_t slots[TC_SLOTS_PER_BATCH];
    struct util_dynarray renderpass_infos;
+   /* Draws whose index bounds are computed by preprocessing (tc_index_bounds). */
+   struct util_dynarray index_bounds;
 };
 
 struct tc_buffer_list {
@@ -565,6 +581,30 @@ struct threaded_context_options {
     */
    void (*dsa_parse)(void *state, struct tc_renderpass_info *info);
    void (*fs_parse)(void *state, struct tc_renderpass_info *info);
+
+   /**
+    * If non-zero, this many helper threads preprocess flushed batches while
+    * the driver thread is still executing earlier batches. They compute
+    * the index bounds of draws with user indices (single draws only with at
+    * least TC_PREPROCESS_MIN_INDEX_COUNT indices), so that the driver gets
+    * pipe_draw_info::index_bounds_valid for them and doesn't have to scan
+    * the indices itself. Only useful for drivers that use the bounds.
+    *
+    * Can be overridden with GALLIUM_THREAD_PREPROCESS.
+    */
+   unsigned num_preprocess_threads;
+
+   /**
+    * If true, the number of slots after which a batch is flushed is adapted
+    * at runtime between TC_MIN_SLOTS_PER_BATCH and TC_SLOTS_PER_BATCH.
+    * Batches get smaller when the driver thread is idle at flush time or
+    * when the application synced since the last flush, so that the driver
+    * thread gets work sooner, and larger when it's busy, so that the
+    * queuing overhead is lower.
+    *
+    * Can be overridden with GALLIUM_THREAD_ADAPTIVE_BATCHES.
+    */
+   bool adaptive_batch_size;
 };
 
 struct tc_vertex_buffers {
@@ -588,6 +628,13 @@ struct threaded_context {
    unsigned num_offloaded_slots;
    unsigned num_direct_slots;
    unsigned num_syncs;
+   unsigned num_batches;
+   uint64_t sync_stall_time; /* in nanoseconds */
+
+   /* The number of slots after which the current batch is flushed. */
+   uint16_t batch_slots_limit;
+   /* num_syncs when batch_slots_limit was last updated. */
+   unsigned batch_slots_limit_num_syncs;
 
    bool use_forced_staging_uploads;
    bool add_all_gfx_bindings_to_buffer_list;
@@ -602,6 +649,8 @@ struct threaded_context {
 
    struct util_queue queue;
    struct util_queue_fence *fence;
+   /* Only initialized if options.num_preprocess_threads != 0. */
+   struct util_queue preprocess_queue;
 
 #ifndef NDEBUG
    /**
@@ -37,6 +37,15 @@
 
 #include "u_upload_mgr.h"
 
+/* The number of full upload buffers kept for recycling. */
+#define U_UPLOAD_MAX_RETIRED 4
+
+/* A full upload buffer waiting to be reused. */
+struct u_upload_retired {
+   struct pipe_resource *buffer;
+   struct pipe_transfer *transfer; /* only kept for persistent mappings */
+   uint8_t *map;
+};
 
 struct u_upload_mgr {
    struct pipe_context *pipe;
@@ -55,6 +64,11 @@ struct u_upload_mgr {
    unsigned offset; /* Aligned offset to the upload buffer, pointing
                      * at the first unused byte. */
    int buffer_private_refcount;
+
+   u_upload_is_busy_func is_busy; /* Set if recycling is enabled. */
+   void *is_busy_data;
+   struct u_upload_retired retired[U_UPLOAD_MAX_RETIRED]; /* oldest first */
+   unsigned num_retired;
 };
 
 
@@ -121,6 +135,14 @@ u_upload_disable_persistent(struct u_upload_mgr *upload)
    upload->map_flags |= PIPE_MAP_FLUSH_EXPLICIT;
 }
 
+void
+u_upload_enable_recycling(struct u_upload_mgr *upload,
+                          u_upload_is_busy_func is_busy, void *data)
+{
+   upload->is_busy = is_busy;
+   upload->is_busy_data = data;
+}
+
 static void
 upload_unmap_internal(struct u_upload_mgr *upload, bool destroying)
 {
@@ -148,10 +170,17 @@ u_upload_unmap(struct u_upload_mgr *upload)
 
 
 static void
-u_upload_release_buffer(struct u_upload_mgr *upload)
+u_upload_release_retired(struct u_upload_mgr *upload,
+                         struct u_upload_retired *retired)
+{
+   if (retired->transfer)
+      pipe_buffer_unmap(upload->pipe, retired->transfer);
+   pipe_resource_reference(&retired->buffer, NULL);
+}
+
+static void
+u_upload_release_buffer(struct u_upload_mgr *upload, bool destroying)
 {
-   /* Unmap and unreference the upload buffer. */
-   upload_unmap_internal(upload, true);
    if (upload->buffer_private_refcount) {
       /* Subtract the remaining private references before unreferencing
        * the buffer. The mega comment below explains it.
@@ -161,33 +190,86 @@ u_upload_release_buffer(struct u_upload_mgr *upload)
                    -upload->buffer_private_refcount);
       upload->buffer_private_refcount = 0;
    }
+
+   if (upload->is_busy && upload->buffer && !destroying) {
+      /* Keep the buffer for recycling, and release the oldest one if there
+       * are too many.
+       */
+      if (upload->num_retired == U_UPLOAD_MAX_RETIRED) {
+         u_upload_release_retired(upload, &upload->retired[0]);
+         memmove(&upload->retired[0], &upload->retired[1],
+                 sizeof(upload->retired[0]) * (U_UPLOAD_MAX_RETIRED - 1));
+         upload->num_retired--;
+      }
+
+      struct u_upload_retired *retired = &upload->retired[upload->num_retired++];
+
+      /* Persistent mappings stay mapped until the buffer is released. */
+      upload_unmap_internal(upload, false);
+      retired->buffer = upload->buffer;
+      retired->transfer = upload->transfer;
+      retired->map = upload->map;
+
+      upload->buffer = NULL;
+      upload->transfer = NULL;
+      upload->map = NULL;
+      upload->buffer_size = 0;
+      return;
+   }
+
+   /* Unmap and unreference the upload buffer. */
+   upload_unmap_internal(upload, true);
    pipe_resource_reference(&upload->buffer, NULL);
    upload->buffer_size = 0;
 }
 
+/* Return a retired buffer of at least "size" bytes that nothing uses
+ * anymore, or NULL.
+ */
+static struct pipe_resource *
+u_upload_recycle_buffer(struct u_upload_mgr *upload, unsigned size)
+{
+   for (unsigned i = 0; i < upload->num_retired; i++) {
+      struct u_upload_retired *retired = &upload->retired[i];
+
+      /* The buffer must only be referenced by us (i.e. it's not bound and
+       * not used by any unexecuted call), and neither used by unflushed
+       * commands nor by the GPU.
+       */
+      if (retired->buffer->width0 < size ||
+          p_atomic_read(&retired->buffer->reference.count) != 1 ||
+          upload->is_busy(upload->is_busy_data, retired->buffer))
+         continue;
+
+      struct pipe_resource *buffer = retired->buffer;
+
+      upload->transfer = retired->transfer;
+      upload->map = retired->map;
+
+      upload->num_retired--;
+      memmove(retired, retired + 1,
+              sizeof(*retired) * (upload->num_retired - i));
+      return buffer;
+   }
+
+   return NULL;
+}
+
 
 void
 u_upload_destroy(struct u_upload_mgr *upload)
 {
-   u_upload_release_buffer(upload);
+   u_upload_release_buffer(upload, true);
+   for (unsigned i = 0; i < upload->num_retired; i++)
+      u_upload_release_retired(upload, &upload->retired[i]);
    FREE(upload);
 }
 
-/* Return the allocated buffer size or 0 if it failed. */
-static unsigned
-u_upload_alloc_buffer(struct u_upload_mgr *upload, unsigned min_size)
+static struct pipe_resource *
+u_upload_create_buffer(struct u_upload_mgr *upload, unsigned size)
 {
    struct pipe_screen *screen = upload->pipe->screen;
    struct pipe_resource buffer;
-   unsigned size;
-
-   /* Release the old buffer, if present:
-    */
-   u_upload_release_buffer(upload);
-
-   /* Allocate a new one:
-    */
-   size = align(MAX2(upload->default_size, min_size), 4096);
 
    memset(&buffer, 0, sizeof buffer);
    buffer.target = PIPE_BUFFER;
@@ -205,7 +287,31 @@ u_upload_alloc_buffer(struct u_upload_mgr *upload, unsigned min_size)
                       PIPE_RESOURCE_FLAG_MAP_COHERENT;
    }
 
-   upload->buffer = screen->resource_create(screen, &buffer);
+   return screen->resource_create(screen, &buffer);
+}
+
+/* Return the allocated buffer size or 0 if it failed. */
+static unsigned
+u_upload_alloc_buffer(struct u_upload_mgr *upload, unsigned min_size)
+{
+   unsigned size;
+
+   /* Release the old buffer, if present:
+    */
+   u_upload_release_buffer(upload, false);
+
+   /* Allocate a new one or recycle an old one:
+    */
+   size = align(MAX2(upload->default_size, min_size), 4096);
+
+   if (upload->is_busy)
+      upload->buffer = u_upload_recycle_buffer(upload, size);
+
+   if (upload->buffer)
+      size = upload->buffer->width0;
+   else
+      upload->buffer = u_upload_create_buffer(upload, size);
+
    if (upload->buffer == NULL)
       return 0;
 
@@ -236,12 +342,14 @@ u_upload_alloc_buffer(struct u_upload_mgr *upload, unsigned min_size)
    assert(upload->buffer_private_refcount < INT32_MAX / 2);
    p_atomic_add(&upload->buffer->reference.count, upload->buffer_private_refcount);
 
-   /* Map the new buffer. */
-   upload->map = pipe_buffer_map_range(upload->pipe, upload->buffer,
-                                       0, size, upload->map_flags,
-                                       &upload->transfer);
+   /* Map the new buffer, unless it's a recycled persistent mapping. */
+   if (!upload->map) {
+      upload->map = pipe_buffer_map_range(upload->pipe, upload->buffer,
+                                          0, size, upload->map_flags,
+                                          &upload->transfer);
+   }
    if (upload->map == NULL) {
-      u_upload_release_buffer(upload);
+      u_upload_release_buffer(upload, true);
       return 0;
    }
 
@@ -38,6 +38,12 @@
 struct pipe_context;
 struct pipe_resource;
 
+/* Return whether the GPU may still access "resource", including through
+ * commands that haven't been flushed yet.
+ */
+typedef bool (*u_upload_is_busy_func)(void *data,
+                                      struct pipe_resource *resource);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -73,6 +79,19 @@ u_upload_clone(struct pipe_context *pipe, struct u_upload_mgr *upload);
 void
 u_upload_disable_persistent(struct u_upload_mgr *upload);
 
+/**
+ * Reuse full upload buffers once nothing references them anymore and
+ * the GPU is done with them, instead of creating new buffers.
+ *
+ * \param is_busy  Returns whether the GPU may still access a buffer,
+ *                 including through unflushed commands. It must be callable
+ *                 from the thread that uses the upload manager.
+ * \param data     Passed to is_busy.
+ */
+void
+u_upload_enable_recycling(struct u_upload_mgr *upload,
+                          u_upload_is_busy_func is_busy, void *data);
+
 /**
  * Destroy the upload manager.
  */
@@ -90,6 +90,10 @@ void u_vbuf_draw_vbo(struct pipe_context *pipe,
                      const struct pipe_draw_indirect_info *indirect,
                      const struct pipe_draw_start_count_bias *draws,
                      unsigned num_draws);
+void u_vbuf_get_minmax_index_mapped(const struct pipe_draw_info *info,
+                                    unsigned count, const void *indices,
+                                    unsigned *out_min_index,
+                                    unsigned *out_max_index);
 void u_vbuf_get_minmax_index(struct pipe_context *pipe,
                              const struct pipe_draw_info *info,
                              const struct pipe_draw_start_count_bias *draw,
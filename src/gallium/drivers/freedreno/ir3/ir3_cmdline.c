@@ -54,6 +54,8 @@
 
 #include "pipe/p_context.h"
 
+#include "util/os_time.h"
+
 static void
 dump_info(struct ir3_shader_variant *so, const char *str)
 {
@@ -433,6 +435,8 @@ main(int argc, char **argv)
    shader->variants = v;
    shader->variant_count = 1;
 
+   int64_t start = os_time_get_nano();
+
    ir3_nir_lower_variant(v, nir);
 
    info = "NIR compiler";
@@ -441,7 +445,17 @@ main(int argc, char **argv)
       fprintf(stderr, "compiler failed!\n");
       return ret;
    }
+
+   int64_t compile_ns = os_time_get_nano() - start;
+
    dump_info(v, info);
 
+   /* Not part of ir3_shader_disasm() so that the CI reference logs stay
+    * stable, but needed by offline stat collection (bin/shader-stats.py).
+    */
+   printf("; %s: %u pvtmem, %u cycles, %.3f ms compile\n",
+          ir3_shader_stage(v), v->pvtmem_size, v->info.cycles,
+          compile_ns / 1000000.0);
+
    return 0;
 }
@@ -74,7 +74,7 @@ struct ra_regs *ppir_regalloc_init(void *mem_ctx)
          ra_class_add_reg(classes[i], j);
    }
 
-   ra_set_finalize(ret, NULL);
+   ra_set_finalize_cached(ret, NULL);
    return ret;
 }
 
@@ -966,6 +966,12 @@ static void si_destroy_screen(struct pipe_screen *pscreen)
    if (sscreen->debug_flags & DBG(CACHE_STATS)) {
       printf("live shader cache:   hits = %u, misses = %u\n", sscreen->live_shader_cache.hits,
              sscreen->live_shader_cache.misses);
+      printf("live sampler states: hits = %u, misses = %u\n",
+             sscreen->live_state_cache.hits[UTIL_LIVE_STATE_SAMPLER],
+             sscreen->live_state_cache.misses[UTIL_LIVE_STATE_SAMPLER]);
+      printf("live velems states:  hits = %u, misses = %u\n",
+             sscreen->live_state_cache.hits[UTIL_LIVE_STATE_VERTEX_ELEMENTS],
+             sscreen->live_state_cache.misses[UTIL_LIVE_STATE_VERTEX_ELEMENTS]);
       printf("memory shader cache: hits = %u, misses = %u\n", sscreen->num_memory_shader_cache_hits,
              sscreen->num_memory_shader_cache_misses);
       printf("disk shader cache:   hits = %u, misses = %u\n", sscreen->num_disk_shader_cache_hits,
@@ -1043,6 +1049,7 @@ static void si_destroy_screen(struct pipe_screen *pscreen)
 
    disk_cache_destroy(sscreen->disk_shader_cache);
    util_live_shader_cache_deinit(&sscreen->live_shader_cache);
+   util_live_state_cache_deinit(&sscreen->live_state_cache);
    util_idalloc_mt_fini(&sscreen->buffer_ids);
    util_vertex_state_cache_deinit(&sscreen->vertex_state_cache);
 
@@ -12,6 +12,7 @@
 #include "winsys/radeon_winsys.h"
 #include "util/u_blitter.h"
 #include "util/u_idalloc.h"
+#include "util/u_live_state_cache.h"
 #include "util/u_suballoc.h"
 #include "util/u_threaded_context.h"
 #include "util/u_vertex_state_cache.h"
@@ -696,6 +697,9 @@ struct si_screen {
    /* Shader cache of live shaders. */
    struct util_live_shader_cache live_shader_cache;
 
+   /* Sampler and vertex element states shared by all contexts. */
+   struct util_live_state_cache live_state_cache;
+
    /* Shader compiler queue for multithreaded compilation. */
    struct util_queue shader_compiler_queue;
    /* Compiler instances for asynchronous shader compilation of new shader CSOs,
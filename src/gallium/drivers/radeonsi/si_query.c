@@ -154,6 +154,15 @@ static bool si_query_sw_begin(struct si_context *sctx, struct si_query *squery)
    case SI_QUERY_TC_NUM_SYNCS:
       query->begin_result = sctx->tc ? sctx->tc->num_syncs : 0;
       break;
+   case SI_QUERY_TC_NUM_BATCHES:
+      query->begin_result = sctx->tc ? sctx->tc->num_batches : 0;
+      break;
+   case SI_QUERY_TC_SYNC_STALL_TIME:
+      query->begin_result = sctx->tc ? p_atomic_read(&sctx->tc->sync_stall_time) : 0;
+      break;
+   case SI_QUERY_TC_BATCH_SIZE:
+      query->begin_result = 0;
+      break;
    case SI_QUERY_REQUESTED_VRAM:
    case SI_QUERY_REQUESTED_GTT:
    case SI_QUERY_MAPPED_VRAM:
@@ -229,6 +238,18 @@ static bool si_query_sw_begin(struct si_context *sctx, struct si_query *squery)
    case SI_QUERY_LIVE_SHADER_CACHE_MISSES:
       query->begin_result = sctx->screen->live_shader_cache.misses;
       break;
+   case SI_QUERY_LIVE_SAMPLER_STATE_HITS:
+      query->begin_result = sctx->screen->live_state_cache.hits[UTIL_LIVE_STATE_SAMPLER];
+      break;
+   case SI_QUERY_LIVE_SAMPLER_STATE_MISSES:
+      query->begin_result = sctx->screen->live_state_cache.misses[UTIL_LIVE_STATE_SAMPLER];
+      break;
+   case SI_QUERY_LIVE_VELEMS_STATE_HITS:
+      query->begin_result = sctx->screen->live_state_cache.hits[UTIL_LIVE_STATE_VERTEX_ELEMENTS];
+      break;
+   case SI_QUERY_LIVE_VELEMS_STATE_MISSES:
+      query->begin_result = sctx->screen->live_state_cache.misses[UTIL_LIVE_STATE_VERTEX_ELEMENTS];
+      break;
    case SI_QUERY_MEMORY_SHADER_CACHE_HITS:
       query->begin_result = sctx->screen->num_memory_shader_cache_hits;
       break;
@@ -310,6 +331,15 @@ static bool si_query_sw_end(struct si_context *sctx, struct si_query *squery)
    case SI_QUERY_TC_NUM_SYNCS:
       query->end_result = sctx->tc ? sctx->tc->num_syncs : 0;
       break;
+   case SI_QUERY_TC_NUM_BATCHES:
+      query->end_result = sctx->tc ? sctx->tc->num_batches : 0;
+      break;
+   case SI_QUERY_TC_SYNC_STALL_TIME:
+      query->end_result = sctx->tc ? p_atomic_read(&sctx->tc->sync_stall_time) : 0;
+      break;
+   case SI_QUERY_TC_BATCH_SIZE:
+      query->end_result = sctx->tc ? sctx->tc->batch_slots_limit : 0;
+      break;
    case SI_QUERY_REQUESTED_VRAM:
    case SI_QUERY_REQUESTED_GTT:
    case SI_QUERY_MAPPED_VRAM:
@@ -386,6 +416,18 @@ static bool si_query_sw_end(struct si_context *sctx, struct si_query *squery)
    case SI_QUERY_LIVE_SHADER_CACHE_MISSES:
       query->end_result = sctx->screen->live_shader_cache.misses;
       break;
+   case SI_QUERY_LIVE_SAMPLER_STATE_HITS:
+      query->end_result = sctx->screen->live_state_cache.hits[UTIL_LIVE_STATE_SAMPLER];
+      break;
+   case SI_QUERY_LIVE_SAMPLER_STATE_MISSES:
+      query->end_result = sctx->screen->live_state_cache.misses[UTIL_LIVE_STATE_SAMPLER];
+      break;
+   case SI_QUERY_LIVE_VELEMS_STATE_HITS:
+      query->end_result = sctx->screen->live_state_cache.hits[UTIL_LIVE_STATE_VERTEX_ELEMENTS];
+      break;
+   case SI_QUERY_LIVE_VELEMS_STATE_MISSES:
+      query->end_result = sctx->screen->live_state_cache.misses[UTIL_LIVE_STATE_VERTEX_ELEMENTS];
+      break;
    case SI_QUERY_MEMORY_SHADER_CACHE_HITS:
       query->end_result = sctx->screen->num_memory_shader_cache_hits;
       break;
@@ -460,6 +502,7 @@ static bool si_query_sw_get_result(struct si_context *sctx, struct si_query *squ
 
    switch (query->b.type) {
    case SI_QUERY_BUFFER_WAIT_TIME:
+   case SI_QUERY_TC_SYNC_STALL_TIME:
    case SI_QUERY_GPU_TEMPERATURE:
       result->u64 /= 1000;
       break;
@@ -1758,6 +1801,9 @@ static struct pipe_driver_query_info si_driver_query_list[] = {
    X("tc-offloaded-slots", TC_OFFLOADED_SLOTS, UINT64, AVERAGE),
    X("tc-direct-slots", TC_DIRECT_SLOTS, UINT64, AVERAGE),
    X("tc-num-syncs", TC_NUM_SYNCS, UINT64, AVERAGE),
+   X("tc-num-batches", TC_NUM_BATCHES, UINT64, AVERAGE),
+   X("tc-sync-stall-time", TC_SYNC_STALL_TIME, MICROSECONDS, CUMULATIVE),
+   X("tc-batch-size", TC_BATCH_SIZE, UINT64, AVERAGE),
    X("CS-thread-busy", CS_THREAD_BUSY, UINT64, AVERAGE),
    X("gallium-thread-busy", GALLIUM_THREAD_BUSY, UINT64, AVERAGE),
    X("requested-VRAM", REQUESTED_VRAM, BYTES, AVERAGE),
@@ -1780,6 +1826,10 @@ static struct pipe_driver_query_info si_driver_query_list[] = {
    X("back-buffer-ps-draw-ratio", BACK_BUFFER_PS_DRAW_RATIO, UINT64, AVERAGE),
    X("live-shader-cache-hits", LIVE_SHADER_CACHE_HITS, UINT, CUMULATIVE),
    X("live-shader-cache-misses", LIVE_SHADER_CACHE_MISSES, UINT, CUMULATIVE),
+   X("live-sampler-state-hits", LIVE_SAMPLER_STATE_HITS, UINT, CUMULATIVE),
+   X("live-sampler-state-misses", LIVE_SAMPLER_STATE_MISSES, UINT, CUMULATIVE),
+   X("live-velems-state-hits", LIVE_VELEMS_STATE_HITS, UINT, CUMULATIVE),
+   X("live-velems-state-misses", LIVE_VELEMS_STATE_MISSES, UINT, CUMULATIVE),
    X("memory-shader-cache-hits", MEMORY_SHADER_CACHE_HITS, UINT, CUMULATIVE),
    X("memory-shader-cache-misses", MEMORY_SHADER_CACHE_MISSES, UINT, CUMULATIVE),
    X("disk-shader-cache-hits", DISK_SHADER_CACHE_HITS, UINT, CUMULATIVE),
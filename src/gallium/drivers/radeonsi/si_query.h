@@ -41,6 +41,9 @@ enum
    SI_QUERY_TC_OFFLOADED_SLOTS,
    SI_QUERY_TC_DIRECT_SLOTS,
    SI_QUERY_TC_NUM_SYNCS,
+   SI_QUERY_TC_NUM_BATCHES,
+   SI_QUERY_TC_SYNC_STALL_TIME,
+   SI_QUERY_TC_BATCH_SIZE,
    SI_QUERY_CS_THREAD_BUSY,
    SI_QUERY_GALLIUM_THREAD_BUSY,
    SI_QUERY_REQUESTED_VRAM,
@@ -94,6 +97,10 @@ enum
    SI_QUERY_GPIN_NUM_SE,
    SI_QUERY_LIVE_SHADER_CACHE_HITS,
    SI_QUERY_LIVE_SHADER_CACHE_MISSES,
+   SI_QUERY_LIVE_SAMPLER_STATE_HITS,
+   SI_QUERY_LIVE_SAMPLER_STATE_MISSES,
+   SI_QUERY_LIVE_VELEMS_STATE_HITS,
+   SI_QUERY_LIVE_VELEMS_STATE_MISSES,
    SI_QUERY_MEMORY_SHADER_CACHE_HITS,
    SI_QUERY_MEMORY_SHADER_CACHE_MISSES,
    SI_QUERY_DISK_SHADER_CACHE_HITS,
@@ -5246,6 +5246,38 @@ static void si_delete_sampler_state(struct pipe_context *ctx, void *state)
    free(state);
 }
 
+static bool si_sampler_uses_border_color(const struct pipe_sampler_state *state)
+{
+   bool linear_filter = state->min_img_filter != PIPE_TEX_FILTER_NEAREST ||
+                        state->mag_img_filter != PIPE_TEX_FILTER_NEAREST;
+
+   return wrap_mode_uses_border_color(state->wrap_s, linear_filter) ||
+          wrap_mode_uses_border_color(state->wrap_t, linear_filter) ||
+          wrap_mode_uses_border_color(state->wrap_r, linear_filter);
+}
+
+/* Sampler states are shared by all contexts through the live state cache,
+ * except those using a border color, which is in a per-context table.
+ */
+static void *si_create_live_sampler_state(struct pipe_context *ctx,
+                                          const struct pipe_sampler_state *state)
+{
+   struct si_screen *sscreen = (struct si_screen *)ctx->screen;
+
+   if (si_sampler_uses_border_color(state))
+      return si_create_sampler_state(ctx, state);
+
+   return util_live_sampler_state_get(ctx, &sscreen->live_state_cache, state);
+}
+
+static void si_delete_live_sampler_state(struct pipe_context *ctx, void *state)
+{
+   struct si_screen *sscreen = (struct si_screen *)ctx->screen;
+
+   if (!util_live_state_release(ctx, &sscreen->live_state_cache, state))
+      si_delete_sampler_state(ctx, state);
+}
+
 /*
  * Vertex elements & buffers
  */
@@ -5545,6 +5577,28 @@ static void si_delete_vertex_element(struct pipe_context *ctx, void *state)
    FREE(state);
 }
 
+/* Vertex elements are shared by all contexts through the live state cache. */
+static void *si_create_live_vertex_elements(struct pipe_context *ctx, unsigned count,
+                                            const struct pipe_vertex_element *elements)
+{
+   struct si_screen *sscreen = (struct si_screen *)ctx->screen;
+
+   return util_live_vertex_elements_state_get(ctx, &sscreen->live_state_cache, count, elements);
+}
+
+static void si_delete_live_vertex_elements(struct pipe_context *ctx, void *state)
+{
+   struct si_context *sctx = (struct si_context *)ctx;
+
+   /* Other contexts may keep using the state, so it's only deleted when the
+    * last reference is dropped. Unbind it from this context now.
+    */
+   if (sctx->vertex_elements == state && state != sctx->no_velems_state)
+      si_bind_vertex_elements(ctx, sctx->no_velems_state);
+
+   util_live_state_release(ctx, &sctx->screen->live_state_cache, state);
+}
+
 static void si_set_vertex_buffers(struct pipe_context *ctx, unsigned count,
                                   const struct pipe_vertex_buffer *buffers)
 {
@@ -5775,8 +5829,8 @@ static void si_emit_cache_flush_state(struct si_context *sctx, unsigned index)
 
 void si_init_state_compute_functions(struct si_context *sctx)
 {
-   sctx->b.create_sampler_state = si_create_sampler_state;
-   sctx->b.delete_sampler_state = si_delete_sampler_state;
+   sctx->b.create_sampler_state = si_create_live_sampler_state;
+   sctx->b.delete_sampler_state = si_delete_live_sampler_state;
    sctx->b.create_sampler_view = si_create_sampler_view;
    sctx->b.sampler_view_destroy = si_sampler_view_destroy;
    sctx->b.memory_barrier = si_memory_barrier;
@@ -5845,9 +5899,9 @@ void si_init_state_functions(struct si_context *sctx)
 
    sctx->b.set_sample_mask = si_set_sample_mask;
 
-   sctx->b.create_vertex_elements_state = si_create_vertex_elements;
+   sctx->b.create_vertex_elements_state = si_create_live_vertex_elements;
    sctx->b.bind_vertex_elements_state = si_bind_vertex_elements;
-   sctx->b.delete_vertex_elements_state = si_delete_vertex_element;
+   sctx->b.delete_vertex_elements_state = si_delete_live_vertex_elements;
    sctx->b.set_vertex_buffers = si_set_vertex_buffers;
 
    sctx->b.texture_barrier = si_texture_barrier;
@@ -5870,6 +5924,9 @@ void si_init_screen_state_functions(struct si_screen *sscreen)
 
    util_vertex_state_cache_init(&sscreen->vertex_state_cache,
                                 si_create_vertex_state, si_vertex_state_destroy);
+   util_live_state_cache_init(&sscreen->live_state_cache,
+                              si_create_sampler_state, si_delete_sampler_state,
+                              si_create_vertex_elements, si_delete_vertex_element);
 }
 
 static void si_set_grbm_gfx_index(struct si_context *sctx, struct si_pm4_state *pm4, unsigned value)
@@ -936,12 +936,13 @@ v3d_screen_create(int fd, const struct pipe_screen_config *config,
 
         v3d_resource_screen_init(pscreen);
 
-        screen->compiler = v3d_compiler_init(&screen->devinfo, 0);
-
 #ifdef ENABLE_SHADER_CACHE
         v3d_disk_cache_init(screen);
 #endif
 
+        screen->compiler = v3d_compiler_init(&screen->devinfo, 0,
+                                             screen->disk_cache);
+
         pscreen->get_name = v3d_screen_get_name;
         pscreen->get_vendor = v3d_screen_get_vendor;
         pscreen->get_device_vendor = v3d_screen_get_vendor;
@@ -176,7 +176,7 @@ vc4_alloc_reg_set(struct vc4_context *vc4)
                 }
         }
 
-        ra_set_finalize(vc4->regs, NULL);
+        ra_set_finalize_cached(vc4->regs, NULL);
 }
 
 struct node_to_temp_map {
@@ -29,6 +29,7 @@
 #include "util/format/u_format.h"
 #include "util/half_float.h"
 #include "util/u_cpu_detect.h"
+#include "util/os_time.h"
 
 /* don't use this for serious use */
 static double rand_double()
@@ -66,6 +67,7 @@ int main(int argc, char** argv)
    unsigned passed = 0;
    unsigned total = 0;
    const float error = 0.03125;
+   bool bench = argc > 2 && !strcmp(argv[2], "bench");
 
    create_fn = 0;
 
@@ -76,6 +78,10 @@ int main(int argc, char** argv)
       create_fn = translate_generic_create;
    else if (!strcmp(argv[1], "x86"))
       create_fn = translate_sse2_create;
+#if DRAW_LLVM_AVAILABLE
+   else if (!strcmp(argv[1], "llvm"))
+      create_fn = translate_llvm_create;
+#endif
    else
    {
       const char *translate_options[] = {
@@ -99,7 +105,7 @@ int main(int argc, char** argv)
 
    if (!create_fn)
    {
-      printf("Usage: ./translate_test [default|generic|x86|nosse|sse|sse2|sse3|ssse3|sse4.1|avx]\n");
+      printf("Usage: ./translate_test [default|generic|x86|llvm|nosse|sse|sse2|sse3|ssse3|sse4.1|avx] [bench]\n");
       return 2;
    }
 
@@ -283,6 +289,27 @@ int main(int argc, char** argv)
             }
          }
 
+         /* Throughput of the input -> output conversion, on buffers small
+          * enough to stay in the cache.
+          */
+         if (bench)
+         {
+            unsigned bench_count = buffer_size / MAX2(input_format_size, output_format_size);
+            unsigned runs = 10000;
+            int64_t start;
+            double seconds;
+
+            translate[0]->set_buffer(translate[0], 0, buffer[0], input_format_size, bench_count - 1);
+            start = os_time_get_nano();
+            for (j = 0; j < runs; ++j)
+               translate[0]->run(translate[0], 0, bench_count, 0, 0, buffer[1]);
+            seconds = (os_time_get_nano() - start) / 1e9;
+
+            printf("BENCH: %s -> %s: %.1f Mvertices/s\n",
+                  input_format_desc->name, output_format_desc->name,
+                  (double)bench_count * runs / seconds / 1e6);
+         }
+
          if (!fail)
             ++passed;
          ++total;
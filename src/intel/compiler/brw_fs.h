@@ -450,6 +450,9 @@ public:
 
    struct shader_stats shader_stats;
 
+   /** Creation time, for INTEL_DEBUG=analysis-stats. */
+   int64_t start_time;
+
    unsigned workgroup_size() const;
 
    void debug_optimizer(const nir_shader *nir,
@@ -87,7 +87,7 @@ fs_live_variables::setup_one_write(struct block_data *bd, fs_inst *inst,
       if (!inst->is_partial_write() && !BITSET_TEST(bd->use, var))
          BITSET_SET(bd->def, var);
 
-      BITSET_SET(bd->defout, var);
+      BITSET_SET(bd->written, var);
    }
 }
 
@@ -150,12 +150,34 @@ fs_live_variables::setup_def_use()
  * propagating it through control flow.  It will eventually terminate
  * because it only ever adds bits, and stops when no bits are added in
  * a pass.
+ *
+ * Only the bitset words listed in \p words (or the first \p num_words if
+ * \p words is NULL) and optionally the flag register are calculated, the
+ * others are left untouched.
  */
 void
-fs_live_variables::compute_live_variables()
+fs_live_variables::compute_live_variables(const int *words, int num_words,
+                                          bool flags)
 {
    bool cont = true;
 
+   foreach_block (block, cfg) {
+      struct block_data *bd = &block_data[block->num];
+
+      for (int j = 0; j < num_words; j++) {
+         const int i = words ? words[j] : j;
+         bd->livein[i] = 0;
+         bd->liveout[i] = 0;
+         bd->defin[i] = 0;
+         bd->defout[i] = bd->written[i];
+      }
+
+      if (flags) {
+         bd->flag_livein[0] = 0;
+         bd->flag_liveout[0] = 0;
+      }
+   }
+
    /* Propagate defin and defout down the CFG to calculate the union of live
     * variables potentially defined along any possible control flow path.
     */
@@ -168,7 +190,8 @@ fs_live_variables::compute_live_variables()
          foreach_list_typed(bblock_link, child_link, link, &block->children) {
             struct block_data *child_bd = &block_data[child_link->block->num];
 
-            for (int i = 0; i < bitset_words; i++) {
+            for (int j = 0; j < num_words; j++) {
+               const int i = words ? words[j] : j;
                const BITSET_WORD new_def = bd->defout[i] & ~child_bd->defin[i];
                child_bd->defin[i] |= new_def;
                child_bd->defout[i] |= new_def;
@@ -188,7 +211,8 @@ fs_live_variables::compute_live_variables()
          foreach_list_typed(bblock_link, child_link, link, &block->children) {
             struct block_data *child_bd = &block_data[child_link->block->num];
 
-            for (int i = 0; i < bitset_words; i++) {
+            for (int j = 0; j < num_words; j++) {
+               const int i = words ? words[j] : j;
                BITSET_WORD new_liveout = (child_bd->livein[i] &
                                           ~bd->liveout[i]);
                new_liveout &= bd->defout[i]; /* Screen off uses with no reaching def */
@@ -197,12 +221,13 @@ fs_live_variables::compute_live_variables()
             }
             BITSET_WORD new_liveout = (child_bd->flag_livein[0] &
                                        ~bd->flag_liveout[0]);
-            if (new_liveout)
+            if (flags && new_liveout)
                bd->flag_liveout[0] |= new_liveout;
          }
 
          /* Update livein */
-         for (int i = 0; i < bitset_words; i++) {
+         for (int j = 0; j < num_words; j++) {
+            const int i = words ? words[j] : j;
             BITSET_WORD new_livein = (bd->use[i] |
                                       (bd->liveout[i] &
                                        ~bd->def[i]));
@@ -215,7 +240,7 @@ fs_live_variables::compute_live_variables()
          BITSET_WORD new_livein = (bd->flag_use[0] |
                                    (bd->flag_liveout[0] &
                                     ~bd->flag_def[0]));
-         if (new_livein & ~bd->flag_livein[0]) {
+         if (flags && (new_livein & ~bd->flag_livein[0])) {
             bd->flag_livein[0] |= new_livein;
             cont = true;
          }
@@ -244,6 +269,40 @@ fs_live_variables::compute_start_end()
          end[i] = MAX2(end[i], block->end_ip);
       }
    }
+
+   /* Merge the per-component live ranges to whole VGRF live ranges. */
+   for (int i = 0; i < num_vars; i++) {
+      const unsigned vgrf = vgrf_from_var[i];
+      vgrf_start[vgrf] = MIN2(vgrf_start[vgrf], start[i]);
+      vgrf_end[vgrf] = MAX2(vgrf_end[vgrf], end[i]);
+   }
+}
+
+/**
+ * Clears the block-local information and live ranges so that they can be
+ * set up again by setup_def_use().
+ */
+void
+fs_live_variables::reset_def_use()
+{
+   for (int i = 0; i < num_vars; i++) {
+      start[i] = MAX_INSTRUCTION;
+      end[i] = -1;
+   }
+
+   for (int i = 0; i < num_vgrfs; i++) {
+      vgrf_start[i] = MAX_INSTRUCTION;
+      vgrf_end[i] = -1;
+   }
+
+   for (int i = 0; i < num_blocks; i++) {
+      memset(block_data[i].def, 0, bitset_words * sizeof(BITSET_WORD));
+      memset(block_data[i].use, 0, bitset_words * sizeof(BITSET_WORD));
+      memset(block_data[i].written, 0, bitset_words * sizeof(BITSET_WORD));
+
+      block_data[i].flag_def[0] = 0;
+      block_data[i].flag_use[0] = 0;
+   }
 }
 
 fs_live_variables::fs_live_variables(const fs_visitor *s)
@@ -268,46 +327,96 @@ fs_live_variables::fs_live_variables(const fs_visitor *s)
    }
 
    start = ralloc_array(mem_ctx, int, num_vars);
-   end = linear_zalloc_array(lin_ctx, int, num_vars);
-   for (int i = 0; i < num_vars; i++) {
-      start[i] = MAX_INSTRUCTION;
-      end[i] = -1;
-   }
-
+   end = ralloc_array(mem_ctx, int, num_vars);
    vgrf_start = ralloc_array(mem_ctx, int, num_vgrfs);
    vgrf_end = ralloc_array(mem_ctx, int, num_vgrfs);
-   for (int i = 0; i < num_vgrfs; i++) {
-      vgrf_start[i] = MAX_INSTRUCTION;
-      vgrf_end[i] = -1;
-   }
 
-   block_data = linear_zalloc_array(lin_ctx, struct block_data, cfg->num_blocks);
+   num_blocks = cfg->num_blocks;
+   block_data = linear_zalloc_array(lin_ctx, struct block_data, num_blocks);
 
    bitset_words = BITSET_WORDS(num_vars);
-   for (int i = 0; i < cfg->num_blocks; i++) {
+   for (int i = 0; i < num_blocks; i++) {
       block_data[i].def = linear_zalloc_array(lin_ctx, BITSET_WORD, bitset_words);
       block_data[i].use = linear_zalloc_array(lin_ctx, BITSET_WORD, bitset_words);
       block_data[i].livein = linear_zalloc_array(lin_ctx, BITSET_WORD, bitset_words);
       block_data[i].liveout = linear_zalloc_array(lin_ctx, BITSET_WORD, bitset_words);
+      block_data[i].written = linear_zalloc_array(lin_ctx, BITSET_WORD, bitset_words);
       block_data[i].defin = linear_zalloc_array(lin_ctx, BITSET_WORD, bitset_words);
       block_data[i].defout = linear_zalloc_array(lin_ctx, BITSET_WORD, bitset_words);
-
-      block_data[i].flag_def[0] = 0;
-      block_data[i].flag_use[0] = 0;
-      block_data[i].flag_livein[0] = 0;
-      block_data[i].flag_liveout[0] = 0;
    }
 
+   reset_def_use();
    setup_def_use();
-   compute_live_variables();
+   compute_live_variables(NULL, bitset_words, true);
    compute_start_end();
+}
 
-   /* Merge the per-component live ranges to whole VGRF live ranges. */
-   for (int i = 0; i < num_vars; i++) {
-      const unsigned vgrf = vgrf_from_var[i];
-      vgrf_start[vgrf] = MIN2(vgrf_start[vgrf], start[i]);
-      vgrf_end[vgrf] = MAX2(vgrf_end[vgrf], end[i]);
+/**
+ * Brings the analysis up to date after instructions were inserted, removed
+ * or modified without changing the set of VGRFs or basic blocks.
+ *
+ * The block-local def/use information and the live ranges are set up again
+ * with a single walk over the program, but the data flow across blocks is
+ * only solved again for the bitset words that contain a variable whose
+ * block-local information changed.  Every variable is an independent data
+ * flow problem, so the result is identical to a calculation from scratch,
+ * and local edits like dead code elimination or copy propagation usually
+ * touch few of the words.
+ */
+void
+fs_live_variables::update(const fs_visitor *s)
+{
+   assert(s->cfg == cfg && cfg->num_blocks == num_blocks);
+   assert(s->alloc.count == unsigned(num_vgrfs));
+
+   void *tmp_ctx = ralloc_context(NULL);
+   const unsigned size = bitset_words * sizeof(BITSET_WORD);
+   BITSET_WORD *old_def = ralloc_array(tmp_ctx, BITSET_WORD, bitset_words * num_blocks);
+   BITSET_WORD *old_use = ralloc_array(tmp_ctx, BITSET_WORD, bitset_words * num_blocks);
+   BITSET_WORD *old_written = ralloc_array(tmp_ctx, BITSET_WORD, bitset_words * num_blocks);
+   BITSET_WORD *old_flag_def = ralloc_array(tmp_ctx, BITSET_WORD, num_blocks);
+   BITSET_WORD *old_flag_use = ralloc_array(tmp_ctx, BITSET_WORD, num_blocks);
+
+   for (int b = 0; b < num_blocks; b++) {
+      memcpy(&old_def[b * bitset_words], block_data[b].def, size);
+      memcpy(&old_use[b * bitset_words], block_data[b].use, size);
+      memcpy(&old_written[b * bitset_words], block_data[b].written, size);
+      old_flag_def[b] = block_data[b].flag_def[0];
+      old_flag_use[b] = block_data[b].flag_use[0];
+   }
+
+   reset_def_use();
+   setup_def_use();
+
+   BITSET_WORD *changed = rzalloc_array(tmp_ctx, BITSET_WORD, bitset_words);
+   BITSET_WORD flags_changed = 0;
+
+   for (int b = 0; b < num_blocks; b++) {
+      const struct block_data *bd = &block_data[b];
+
+      for (int i = 0; i < bitset_words; i++) {
+         changed[i] |= (old_def[b * bitset_words + i] ^ bd->def[i]) |
+                       (old_use[b * bitset_words + i] ^ bd->use[i]) |
+                       (old_written[b * bitset_words + i] ^ bd->written[i]);
+      }
+
+      flags_changed |= (old_flag_def[b] ^ bd->flag_def[0]) |
+                   (old_flag_use[b] ^ bd->flag_use[0]);
+   }
+
+   int *words = ralloc_array(tmp_ctx, int, bitset_words);
+   int num_words = 0;
+   for (int i = 0; i < bitset_words; i++) {
+      if (changed[i])
+         words[num_words++] = i;
    }
+
+   if (num_words || flags_changed)
+      compute_live_variables(words, num_words, flags_changed != 0);
+
+   compute_start_end();
+
+   ralloc_free(tmp_ctx);
 }
 
 fs_live_variables::~fs_live_variables()
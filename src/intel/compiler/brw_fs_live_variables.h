@@ -59,6 +59,12 @@ public:
       /** Which defs reach the exit point of the block. */
       BITSET_WORD *liveout;
 
+      /**
+       * Which variables are written at all in the block, the local part of
+       * defout.
+       */
+      BITSET_WORD *written;
+
       /**
        * Variables such that the entry point of the block may be reached from any
        * of their definitions.
@@ -90,6 +96,18 @@ public:
               DEPENDENCY_VARIABLES);
    }
 
+   /**
+    * Instruction changes can be handled incrementally as long as the set of
+    * VGRFs and blocks stays the same, see update().
+    */
+   analysis_dependency_class
+   update_class() const
+   {
+      return DEPENDENCY_INSTRUCTIONS;
+   }
+
+   void update(const fs_visitor *s);
+
    bool vars_interfere(int a, int b) const;
    bool vgrfs_interfere(int a, int b) const;
    int var_from_reg(const fs_reg &reg) const
@@ -131,15 +149,17 @@ public:
    struct block_data *block_data;
 
 protected:
+   void reset_def_use();
    void setup_def_use();
    void setup_one_read(struct block_data *bd, int ip, const fs_reg &reg);
    void setup_one_write(struct block_data *bd, fs_inst *inst, int ip,
                         const fs_reg &reg);
-   void compute_live_variables();
+   void compute_live_variables(const int *words, int num_words, bool flags);
    void compute_start_end();
 
    const struct intel_device_info *devinfo;
    const cfg_t *cfg;
+   int num_blocks;
    void *mem_ctx;
 };
 
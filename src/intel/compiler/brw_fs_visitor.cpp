@@ -32,6 +32,7 @@
 #include "brw_fs_builder.h"
 #include "brw_nir.h"
 #include "compiler/glsl_types.h"
+#include "dev/intel_debug.h"
 
 using namespace brw;
 
@@ -1119,9 +1120,37 @@ fs_visitor::init()
 
    this->grf_used = 0;
    this->spilled_any_registers = false;
+
+   this->start_time = INTEL_DEBUG(DEBUG_ANALYSIS_STATS) ? os_time_get_nano() : 0;
+}
+
+static void
+print_analysis_stats(const char *name, const analysis_stats &stats)
+{
+   fprintf(stderr, ", %s %u+%u %.3f ms", name, stats.full, stats.incremental,
+           stats.ns / 1000000.0);
 }
 
 fs_visitor::~fs_visitor()
 {
+   if (INTEL_DEBUG(DEBUG_ANALYSIS_STATS)) {
+      const uint64_t total_ns = os_time_get_nano() - start_time;
+      const uint64_t analysis_ns = live_analysis.stats.ns +
+                                   regpressure_analysis.stats.ns +
+                                   performance_analysis.stats.ns +
+                                   idom_analysis.stats.ns;
+
+      /* Counts are printed as "full+incremental" calculations. */
+      fprintf(stderr, "%s SIMD%u analyses: %.3f of %.3f ms (%.1f%%)",
+              _mesa_shader_stage_to_abbrev(stage), dispatch_width,
+              analysis_ns / 1000000.0, total_ns / 1000000.0,
+              total_ns ? analysis_ns * 100.0 / total_ns : 0.0);
+      print_analysis_stats("live", live_analysis.stats);
+      print_analysis_stats("regpressure", regpressure_analysis.stats);
+      print_analysis_stats("performance", performance_analysis.stats);
+      print_analysis_stats("idom", idom_analysis.stats);
+      fprintf(stderr, "\n");
+   }
+
    delete this->payload_;
 }
@@ -25,6 +25,10 @@
 #ifndef BRW_IR_ANALYSIS_H
 #define BRW_IR_ANALYSIS_H
 
+#include "dev/intel_debug.h"
+#include "util/macros.h"
+#include "util/os_time.h"
+
 namespace brw {
    /**
     * Bitset of state categories that can influence the result of IR analysis
@@ -96,6 +100,49 @@ namespace brw {
       return static_cast<analysis_dependency_class>(
          static_cast<unsigned>(x) | static_cast<unsigned>(y));
    }
+
+   /**
+    * Dependency classes whose invalidation an analysis result can absorb
+    * with an incremental update instead of being recalculated from scratch.
+    * Analyses opt in by implementing update_class() and update().
+    */
+   template<class T>
+   auto
+   incremental_dependency_class(const T *p, int) -> decltype(p->update_class())
+   {
+      return p->update_class();
+   }
+
+   template<class T>
+   analysis_dependency_class
+   incremental_dependency_class(const T *, ...)
+   {
+      return DEPENDENCY_NOTHING;
+   }
+
+   template<class T, class C>
+   auto
+   update_analysis(T *p, const C *c, int) -> decltype(p->update(c))
+   {
+      return p->update(c);
+   }
+
+   template<class T, class C>
+   void
+   update_analysis(T *, const C *, ...)
+   {
+      unreachable("Analysis doesn't support incremental updates");
+   }
+
+   /**
+    * Number of times an analysis was calculated and the time spent on it,
+    * for INTEL_DEBUG=analysis-stats.
+    */
+   struct analysis_stats {
+      unsigned full;
+      unsigned incremental;
+      uint64_t ns;
+   };
 }
 
 /**
@@ -138,7 +185,7 @@ public:
     * passed as argument to the constructor of the analysis result
     * object of type \p T.
     */
-   brw_analysis(const C *c) : c(c), p(NULL) {}
+   brw_analysis(const C *c) : stats(), c(c), p(NULL), stale(false) {}
 
    /**
     * Destroy a program analysis.
@@ -156,11 +203,26 @@ public:
    T &
    require()
    {
-      if (p)
+      if (p && !stale) {
+         assert(p->validate(c));
+         return *p;
+      }
+
+      const bool timed = INTEL_DEBUG(DEBUG_ANALYSIS_STATS);
+      const int64_t start = timed ? os_time_get_nano() : 0;
+
+      if (p) {
+         brw::update_analysis(p, c, 0);
+         stale = false;
+         stats.incremental++;
          assert(p->validate(c));
-      else
+      } else {
          p = new T(c);
+         stats.full++;
+      }
 
+      if (timed)
+         stats.ns += os_time_get_nano() - start;
       return *p;
    }
 
@@ -173,20 +235,35 @@ public:
    /**
     * Report that dependencies of the analysis pass may have changed
     * since the last calculation and the cached analysis result may
-    * have to be discarded.
+    * have to be discarded, or updated incrementally on the next
+    * require() if the analysis supports it for all of the changes in
+    * \p c.
     */
    void
    invalidate(brw::analysis_dependency_class c)
    {
       if (p && (c & p->dependency_class())) {
-         delete p;
-         p = NULL;
+         if (c & ~brw::incremental_dependency_class(p, 0)) {
+            delete p;
+            p = NULL;
+            stale = false;
+         } else {
+            stale = true;
+         }
       }
    }
 
+   brw::analysis_stats stats;
+
 private:
    const C *c;
    T *p;
+
+   /**
+    * Whether the cached result has to be brought up to date with
+    * T::update() before it can be used again.
+    */
+   bool stale;
 };
 
 #endif
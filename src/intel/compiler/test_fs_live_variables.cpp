@@ -0,0 +1,211 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include "brw_fs.h"
+#include "brw_fs_builder.h"
+#include "brw_cfg.h"
+
+using namespace brw;
+
+class live_variables_test : public ::testing::Test {
+protected:
+   live_variables_test();
+   ~live_variables_test() override;
+
+   struct brw_compiler *compiler;
+   struct brw_compile_params params;
+   struct intel_device_info *devinfo;
+   void *ctx;
+   struct brw_wm_prog_data *prog_data;
+   fs_visitor *v;
+   fs_builder bld;
+};
+
+live_variables_test::live_variables_test()
+   : bld(NULL, 0)
+{
+   ctx = ralloc_context(NULL);
+   compiler = rzalloc(ctx, struct brw_compiler);
+   devinfo = rzalloc(ctx, struct intel_device_info);
+   devinfo->ver = 9;
+   devinfo->verx10 = devinfo->ver * 10;
+
+   compiler->devinfo = devinfo;
+
+   params = {};
+   params.mem_ctx = ctx;
+
+   prog_data = ralloc(ctx, struct brw_wm_prog_data);
+   nir_shader *shader =
+      nir_shader_create(ctx, MESA_SHADER_FRAGMENT, NULL, NULL);
+
+   v = new fs_visitor(compiler, &params, NULL, &prog_data->base, shader, 8,
+                      false, false);
+
+   bld = fs_builder(v).at_end();
+}
+
+live_variables_test::~live_variables_test()
+{
+   delete v;
+   v = NULL;
+
+   ralloc_free(ctx);
+   ctx = NULL;
+}
+
+static fs_inst *
+instruction(bblock_t *block, int num)
+{
+   fs_inst *inst = (fs_inst *)block->start();
+   for (int i = 0; i < num; i++) {
+      inst = (fs_inst *)inst->next;
+   }
+   return inst;
+}
+
+/**
+ * Checks that the live variables of \p v match a calculation from scratch.
+ */
+static void
+expect_up_to_date(fs_visitor *v)
+{
+   const fs_live_variables &live = v->live_analysis.require();
+   const fs_live_variables ref(v);
+
+   ASSERT_EQ(live.num_vars, ref.num_vars);
+   ASSERT_EQ(live.num_vgrfs, ref.num_vgrfs);
+
+   for (int i = 0; i < ref.num_vars; i++) {
+      EXPECT_EQ(live.start[i], ref.start[i]) << "var " << i;
+      EXPECT_EQ(live.end[i], ref.end[i]) << "var " << i;
+   }
+
+   for (int i = 0; i < ref.num_vgrfs; i++) {
+      EXPECT_EQ(live.vgrf_start[i], ref.vgrf_start[i]) << "vgrf " << i;
+      EXPECT_EQ(live.vgrf_end[i], ref.vgrf_end[i]) << "vgrf " << i;
+   }
+
+   for (int b = 0; b < v->cfg->num_blocks; b++) {
+      const struct fs_live_variables::block_data &bd = live.block_data[b];
+      const struct fs_live_variables::block_data &ref_bd = ref.block_data[b];
+
+      for (int i = 0; i < ref.bitset_words; i++) {
+         EXPECT_EQ(bd.livein[i], ref_bd.livein[i]) << "block " << b;
+         EXPECT_EQ(bd.liveout[i], ref_bd.liveout[i]) << "block " << b;
+         EXPECT_EQ(bd.defin[i], ref_bd.defin[i]) << "block " << b;
+         EXPECT_EQ(bd.defout[i], ref_bd.defout[i]) << "block " << b;
+      }
+
+      EXPECT_EQ(bd.flag_livein[0], ref_bd.flag_livein[0]) << "block " << b;
+      EXPECT_EQ(bd.flag_liveout[0], ref_bd.flag_liveout[0]) << "block " << b;
+   }
+}
+
+static void
+emit_conditional(fs_visitor *v, const fs_builder &bld, fs_reg *g, unsigned n)
+{
+   for (unsigned i = 0; i < n; i++)
+      g[i] = v->vgrf(glsl_float_type());
+
+   bld.ADD(g[2], g[0], g[1]);
+   bld.ADD(g[3], g[0], g[1]);
+   bld.CMP(bld.null_reg_f(), g[2], brw_imm_f(0.0f), BRW_CONDITIONAL_NZ);
+   bld.IF(BRW_PREDICATE_NORMAL);
+   bld.MUL(g[4], g[2], g[3]);
+   bld.emit(BRW_OPCODE_ELSE);
+   bld.MOV(g[4], g[3]);
+   bld.emit(BRW_OPCODE_ENDIF);
+   bld.ADD(g[5], g[4], g[2]);
+   bld.MOV(g[6], g[5]);
+}
+
+TEST_F(live_variables_test, dead_code_elimination)
+{
+   fs_reg g[8];
+   emit_conditional(v, bld, g, ARRAY_SIZE(g));
+
+   /* g[7] is never read. */
+   bld.ADD(g[7], g[5], g[2]);
+   bld.MUL(g[6], g[6], g[5]);
+   bld.emit(FS_OPCODE_SCHEDULING_FENCE, bld.null_reg_ud(), g[6]);
+
+   v->calculate_cfg();
+   v->live_analysis.require();
+
+   EXPECT_TRUE(brw_fs_opt_dead_code_eliminate(*v));
+
+   expect_up_to_date(v);
+   EXPECT_EQ(1u, v->live_analysis.stats.full);
+   EXPECT_EQ(1u, v->live_analysis.stats.incremental);
+}
+
+TEST_F(live_variables_test, source_rewrite)
+{
+   fs_reg g[8];
+   emit_conditional(v, bld, g, ARRAY_SIZE(g));
+   bld.emit(FS_OPCODE_SCHEDULING_FENCE, bld.null_reg_ud(), g[6]);
+
+   v->calculate_cfg();
+   v->live_analysis.require();
+
+   /* Read g[3] instead of g[2] after the ENDIF, like copy propagation
+    * would, which changes the liveness of both across the IF.
+    */
+   fs_inst *add = instruction(v->cfg->blocks[3], 1);
+   ASSERT_EQ(add->opcode, BRW_OPCODE_ADD);
+   add->src[1] = g[3];
+   v->invalidate_analysis(DEPENDENCY_INSTRUCTION_DATA_FLOW |
+                          DEPENDENCY_INSTRUCTION_DETAIL);
+
+   expect_up_to_date(v);
+   EXPECT_EQ(1u, v->live_analysis.stats.full);
+   EXPECT_EQ(1u, v->live_analysis.stats.incremental);
+}
+
+TEST_F(live_variables_test, insertion)
+{
+   fs_reg g[8];
+   emit_conditional(v, bld, g, ARRAY_SIZE(g));
+   bld.emit(FS_OPCODE_SCHEDULING_FENCE, bld.null_reg_ud(), g[6]);
+
+   v->calculate_cfg();
+   v->live_analysis.require();
+
+   /* Redefine g[0] inside the ELSE branch, shifting all later IPs. */
+   bblock_t *block = v->cfg->blocks[2];
+   fs_inst *mov = instruction(block, 0);
+   ASSERT_EQ(mov->opcode, BRW_OPCODE_MOV);
+   bld.at(block, mov).MOV(g[0], brw_imm_f(1.0f));
+   bld.at(block, mov).MOV(g[1], g[0]);
+   v->invalidate_analysis(DEPENDENCY_INSTRUCTIONS);
+
+   expect_up_to_date(v);
+   EXPECT_EQ(1u, v->live_analysis.stats.full);
+   EXPECT_EQ(1u, v->live_analysis.stats.incremental);
+}
+
+TEST_F(live_variables_test, new_variables)
+{
+   fs_reg g[8];
+   emit_conditional(v, bld, g, ARRAY_SIZE(g));
+   bld.emit(FS_OPCODE_SCHEDULING_FENCE, bld.null_reg_ud(), g[6]);
+
+   v->calculate_cfg();
+   v->live_analysis.require();
+
+   /* Allocating a VGRF changes the variable numbering, which can't be
+    * handled incrementally.
+    */
+   fs_reg tmp = v->vgrf(glsl_float_type());
+   bblock_t *block = v->cfg->blocks[3];
+   bld.at(block, instruction(block, 1)).MOV(tmp, g[0]);
+   v->invalidate_analysis(DEPENDENCY_INSTRUCTIONS | DEPENDENCY_VARIABLES);
+
+   expect_up_to_date(v);
+   EXPECT_EQ(2u, v->live_analysis.stats.full);
+   EXPECT_EQ(0u, v->live_analysis.stats.incremental);
+}
@@ -106,6 +106,7 @@ static const struct debug_control debug_control[] = {
    { "sparse",      DEBUG_SPARSE },
    { "draw_bkp",    DEBUG_DRAW_BKP },
    { "bat-stats",   DEBUG_BATCH_STATS },
+   { "analysis-stats", DEBUG_ANALYSIS_STATS },
    { NULL,    0 }
 };
 
@@ -31,6 +31,7 @@
 
 #include "state_tracker/st_context.h"
 #include "state_tracker/st_cb_bitmap.h"
+#include "state_tracker/st_cpu_stats.h"
 #include "state_tracker/st_util.h"
 
 static bool
@@ -298,6 +299,15 @@ prepare_compute(struct gl_context *ctx)
    st_validate_state(st, ST_PIPELINE_COMPUTE_STATE_MASK);
 }
 
+static void
+launch_grid(struct gl_context *ctx, const struct pipe_grid_info *info)
+{
+   int64_t start = st_cpu_stats_begin(ctx->st, ST_CPU_STATS_LAUNCH_GRID);
+
+   ctx->pipe->launch_grid(ctx->pipe, info);
+   st_cpu_stats_end(ctx->st, ST_CPU_STATS_LAUNCH_GRID, start);
+}
+
 static ALWAYS_INLINE void
 dispatch_compute(GLuint num_groups_x, GLuint num_groups_y,
                  GLuint num_groups_z, bool no_error)
@@ -328,7 +338,7 @@ dispatch_compute(GLuint num_groups_x, GLuint num_groups_y,
    info.block[2] = prog->info.workgroup_size[2];
 
    prepare_compute(ctx);
-   ctx->pipe->launch_grid(ctx->pipe, &info);
+   launch_grid(ctx, &info);
 
    if (MESA_DEBUG_FLAGS & DEBUG_ALWAYS_FLUSH)
       _mesa_flush(ctx);
@@ -373,7 +383,7 @@ dispatch_compute_indirect(GLintptr indirect, bool no_error)
    info.block[2] = prog->info.workgroup_size[2];
 
    prepare_compute(ctx);
-   ctx->pipe->launch_grid(ctx->pipe, &info);
+   launch_grid(ctx, &info);
 
    if (MESA_DEBUG_FLAGS & DEBUG_ALWAYS_FLUSH)
       _mesa_flush(ctx);
@@ -423,7 +433,7 @@ dispatch_compute_group_size(GLuint num_groups_x, GLuint num_groups_y,
        return;
 
    prepare_compute(ctx);
-   ctx->pipe->launch_grid(ctx->pipe, &info);
+   launch_grid(ctx, &info);
 
    if (MESA_DEBUG_FLAGS & DEBUG_ALWAYS_FLUSH)
       _mesa_flush(ctx);
@@ -10862,6 +10862,15 @@ execute_list(struct gl_context *ctx, GLuint list)
    while (1) {
       const OpCode opcode = n[0].opcode;
 
+      /* Vertex lists keep their VAO bound for the following vertex lists.
+       * Restore the draw VAO before executing anything else.
+       */
+      if (unlikely(ctx->vbo_context.save.playback_vao_bound) &&
+          opcode != OPCODE_VERTEX_LIST &&
+          opcode != OPCODE_VERTEX_LIST_COPY_CURRENT &&
+          opcode != OPCODE_CONTINUE)
+         vbo_save_playback_restore_draw_vao(ctx);
+
       switch (opcode) {
          case OPCODE_ERROR:
             _mesa_error(ctx, n[1].e, "%s", (const char *) get_pointer(&n[2]));
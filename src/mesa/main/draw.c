@@ -1624,10 +1624,13 @@ _mesa_validated_drawrangeelements(struct gl_context *ctx,
     *   vertex formats are also supported by the driver)
     * - DrawID is 0 (true if glthread isn't unrolling an indirect multi draw,
     *   which is almost always true)
+    * - ST_DEBUG=cpustats is disabled, so that st_draw_gallium can time the
+    *   draw
     */
    struct st_context *st = st_context(ctx);
    if (index_bo && ctx->Driver.DrawGallium == st_draw_gallium &&
-       st->cso_context->draw_vbo == tc_draw_vbo && ctx->DrawID == 0) {
+       st->cso_context->draw_vbo == tc_draw_vbo && ctx->DrawID == 0 &&
+       !st->cpu_stats) {
       assert(!st->draw_needs_minmax_index);
       struct pipe_resource *index_buffer =
          _mesa_get_bufferobj_reference(ctx, index_bo);
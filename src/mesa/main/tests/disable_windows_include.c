@@ -108,7 +108,6 @@
 #include <mesa/main/shader_types.h>
 #include <mesa/main/shared.h>
 #include <mesa/main/spirv_extensions.h>
-#include <mesa/main/sse_minmax.h>
 #include <mesa/main/state.h>
 #include <mesa/main/stencil.h>
 #include <mesa/main/syncobj.h>
@@ -45,6 +45,7 @@
 #include "st_atom.h"
 #include "st_cb_bitmap.h"
 #include "st_cb_clear.h"
+#include "st_cpu_stats.h"
 #include "st_draw.h"
 #include "st_format.h"
 #include "st_nir.h"
@@ -502,9 +503,11 @@ st_Clear(struct gl_context *ctx, GLbitfield mask)
       /* We can't translate the clear color to the colorbuffer format,
        * because different colorbuffers may have different formats.
        */
+      int64_t start = st_cpu_stats_begin(st, ST_CPU_STATS_CLEAR);
       st->pipe->clear(st->pipe, clear_buffers, have_scissor_buffers ? &scissor_state : NULL,
                       (union pipe_color_union*)&ctx->Color.ClearColor,
                       ctx->Depth.Clear, ctx->Stencil.Clear);
+      st_cpu_stats_end(st, ST_CPU_STATS_CLEAR, start);
    }
    if (quad_buffers) {
       clear_with_quad(ctx, quad_buffers);
@@ -39,6 +39,7 @@
 #include "st_cb_flush.h"
 #include "st_cb_clear.h"
 #include "st_context.h"
+#include "st_cpu_stats.h"
 #include "st_manager.h"
 #include "pipe/p_context.h"
 #include "pipe/p_defines.h"
@@ -60,7 +61,10 @@ st_flush(struct st_context *st,
    st_context_free_zombie_objects(st);
 
    st_flush_bitmap_cache(st);
+
+   int64_t start = st_cpu_stats_begin(st, ST_CPU_STATS_FLUSH);
    st->pipe->flush(st->pipe, fence, flags);
+   st_cpu_stats_end(st, ST_CPU_STATS_FLUSH, start);
 }
 
 
@@ -40,6 +40,7 @@
 #include "glapi/glapi.h"
 #include "st_manager.h"
 #include "st_context.h"
+#include "st_cpu_stats.h"
 #include "st_debug.h"
 #include "st_cb_bitmap.h"
 #include "st_cb_clear.h"
@@ -334,6 +335,7 @@ st_context_free_zombie_objects(struct st_context *st)
 static void
 st_destroy_context_priv(struct st_context *st, bool destroy_pipe)
 {
+   st_destroy_cpu_stats(st);
    st_destroy_draw(st);
    st_destroy_clear(st);
    st_destroy_bitmap(st);
@@ -771,6 +773,7 @@ st_create_context_priv(struct gl_context *ctx, struct pipe_context *pipe,
 
    st_init_driver_flags(st);
    st_init_update_array(st);
+   st_init_cpu_stats(st);
 
    /* Initialize context's winsys buffers list */
    list_inithead(&st->winsys_buffers);
@@ -132,6 +132,9 @@ struct st_context
    /* The list of state update functions. */
    st_update_func_t update_functions[ST_NUM_ATOMS];
 
+   /* ST_DEBUG=cpustats */
+   struct st_cpu_stats *cpu_stats;
+
    struct pipe_frontend_screen *frontend_screen; /* e.g. dri_screen */
    void *frontend_context; /* e.g. dri_context */
 
@@ -0,0 +1,152 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "util/u_memory.h"
+
+#include "st_atom.h"
+#include "st_context.h"
+#include "st_cpu_stats.h"
+#include "st_debug.h"
+
+const char *st_cpu_stats_entry_names[ST_CPU_STATS_NUM_ENTRIES] = {
+   [ST_CPU_STATS_DRAW_VBO] = "draw_vbo",
+   [ST_CPU_STATS_LAUNCH_GRID] = "launch_grid",
+   [ST_CPU_STATS_CLEAR] = "clear",
+   [ST_CPU_STATS_FLUSH] = "flush",
+   [ST_CPU_STATS_CREATE_SAMPLER_VIEW] = "create_sampler_view",
+};
+
+static const char *atom_names[ST_NUM_ATOMS] = {
+#define ST_STATE(FLAG, st_update) [FLAG##_INDEX] = #st_update,
+#include "st_atom_list.h"
+#undef ST_STATE
+};
+
+static inline void
+run_atom(struct st_context *st, unsigned index)
+{
+   struct st_cpu_stats_counter *counter = &st->cpu_stats->atoms[index];
+
+   _MESA_TRACE_BEGIN(atom_names[index]);
+   int64_t start = os_time_get_nano();
+
+   st->cpu_stats->update_functions[index](st);
+
+   counter->nsec += os_time_get_nano() - start;
+   counter->calls++;
+   _MESA_TRACE_END();
+}
+
+/* The wrappers need to know the atom index, so generate one per atom. */
+#define ST_STATE(FLAG, st_update)                                          \
+   static void                                                             \
+   run_##FLAG(struct st_context *st)                                       \
+   {                                                                       \
+      run_atom(st, FLAG##_INDEX);                                          \
+   }
+#include "st_atom_list.h"
+#undef ST_STATE
+
+static const st_update_func_t atom_wrappers[ST_NUM_ATOMS] = {
+#define ST_STATE(FLAG, st_update) [FLAG##_INDEX] = run_##FLAG,
+#include "st_atom_list.h"
+#undef ST_STATE
+};
+
+/**
+ * Install the atom wrappers if ST_DEBUG=cpustats is set. This must be
+ * called after all update functions are selected.
+ */
+void
+st_init_cpu_stats(struct st_context *st)
+{
+   if (!(ST_DEBUG & DEBUG_CPU_STATS))
+      return;
+
+   st->cpu_stats = CALLOC_STRUCT(st_cpu_stats);
+   if (!st->cpu_stats)
+      return;
+
+   memcpy(st->cpu_stats->update_functions, st->update_functions,
+          sizeof(st->update_functions));
+   memcpy(st->update_functions, atom_wrappers, sizeof(atom_wrappers));
+}
+
+struct stats_line {
+   const char *kind;
+   const char *name;
+   const struct st_cpu_stats_counter *counter;
+};
+
+static int
+compare_lines(const void *a, const void *b)
+{
+   const struct stats_line *la = a, *lb = b;
+
+   if (la->counter->nsec != lb->counter->nsec)
+      return la->counter->nsec < lb->counter->nsec ? 1 : -1;
+   return 0;
+}
+
+static void
+print_cpu_stats(const struct st_cpu_stats *stats)
+{
+   struct stats_line lines[ST_NUM_ATOMS + ST_CPU_STATS_NUM_ENTRIES];
+   unsigned num_lines = 0;
+   uint64_t total = 0;
+
+   for (unsigned i = 0; i < ST_NUM_ATOMS; i++) {
+      if (stats->atoms[i].calls) {
+         lines[num_lines++] = (struct stats_line){"atom", atom_names[i],
+                                                  &stats->atoms[i]};
+         total += stats->atoms[i].nsec;
+      }
+   }
+   for (unsigned i = 0; i < ST_CPU_STATS_NUM_ENTRIES; i++) {
+      if (stats->entries[i].calls) {
+         lines[num_lines++] = (struct stats_line){"pipe",
+                                                  st_cpu_stats_entry_names[i],
+                                                  &stats->entries[i]};
+         total += stats->entries[i].nsec;
+      }
+   }
+
+   if (!num_lines)
+      return;
+
+   qsort(lines, num_lines, sizeof(lines[0]), compare_lines);
+
+   fprintf(stderr, "st/mesa CPU stats:\n");
+   fprintf(stderr, "  %-4s %-32s %12s %12s %10s %6s\n",
+           "kind", "name", "calls", "total (ms)", "avg (ns)", "%");
+   for (unsigned i = 0; i < num_lines; i++) {
+      const struct st_cpu_stats_counter *c = lines[i].counter;
+
+      fprintf(stderr, "  %-4s %-32s %12" PRIu64 " %12.3f %10" PRIu64 " %5.1f%%\n",
+              lines[i].kind, lines[i].name, c->calls, c->nsec / 1e6,
+              c->nsec / c->calls, total ? 100.0 * c->nsec / total : 0.0);
+   }
+}
+
+/**
+ * Print the summary, restore the real update functions and free the stats.
+ */
+void
+st_destroy_cpu_stats(struct st_context *st)
+{
+   if (!st->cpu_stats)
+      return;
+
+   print_cpu_stats(st->cpu_stats);
+
+   memcpy(st->update_functions, st->cpu_stats->update_functions,
+          sizeof(st->update_functions));
+   FREE(st->cpu_stats);
+   st->cpu_stats = NULL;
+}
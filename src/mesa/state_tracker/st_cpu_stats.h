@@ -0,0 +1,90 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/* CPU time statistics of state atoms and driver entrypoints, enabled by
+ * ST_DEBUG=cpustats.
+ *
+ * Atoms are measured by replacing st_context::update_functions with
+ * wrappers, so there is no overhead when this is disabled. Driver
+ * entrypoints are measured at the call sites with st_cpu_stats_begin/end.
+ * Draws in GL_FEEDBACK mode, and GL_SELECT mode without hardware
+ * acceleration, are rasterized by the draw module on the CPU and never
+ * reach the driver, so they aren't counted.
+ *
+ * Every measured call is also emitted as a Perfetto slice when tracing
+ * is enabled, and a summary is printed when the context is destroyed.
+ */
+
+#ifndef ST_CPU_STATS_H
+#define ST_CPU_STATS_H
+
+#include "util/os_time.h"
+#include "util/perf/cpu_trace.h"
+
+#include "st_context.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum st_cpu_stats_entry {
+   ST_CPU_STATS_DRAW_VBO,
+   ST_CPU_STATS_LAUNCH_GRID,
+   ST_CPU_STATS_CLEAR,
+   ST_CPU_STATS_FLUSH,
+   ST_CPU_STATS_CREATE_SAMPLER_VIEW,
+   ST_CPU_STATS_NUM_ENTRIES,
+};
+
+struct st_cpu_stats_counter {
+   uint64_t calls;
+   uint64_t nsec;
+};
+
+struct st_cpu_stats {
+   /* The real state update functions called by the wrappers. */
+   st_update_func_t update_functions[ST_NUM_ATOMS];
+
+   struct st_cpu_stats_counter atoms[ST_NUM_ATOMS];
+   struct st_cpu_stats_counter entries[ST_CPU_STATS_NUM_ENTRIES];
+};
+
+extern const char *st_cpu_stats_entry_names[ST_CPU_STATS_NUM_ENTRIES];
+
+void
+st_init_cpu_stats(struct st_context *st);
+
+void
+st_destroy_cpu_stats(struct st_context *st);
+
+static inline int64_t
+st_cpu_stats_begin(struct st_context *st, enum st_cpu_stats_entry entry)
+{
+   if (likely(!st->cpu_stats))
+      return 0;
+
+   _MESA_TRACE_BEGIN(st_cpu_stats_entry_names[entry]);
+   return os_time_get_nano();
+}
+
+static inline void
+st_cpu_stats_end(struct st_context *st, enum st_cpu_stats_entry entry,
+                 int64_t start)
+{
+   if (likely(!st->cpu_stats))
+      return;
+
+   struct st_cpu_stats_counter *counter = &st->cpu_stats->entries[entry];
+
+   counter->nsec += os_time_get_nano() - start;
+   counter->calls++;
+   _MESA_TRACE_END();
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_CPU_STATS_H */
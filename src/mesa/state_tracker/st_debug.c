@@ -52,6 +52,7 @@ static const struct debug_named_value st_debug_flags[] = {
    { "wf",       DEBUG_WIREFRAME, NULL },
    { "gremedy",  DEBUG_GREMEDY, "Enable GREMEDY debug extensions" },
    { "noreadpixcache", DEBUG_NOREADPIXCACHE, NULL },
+   { "cpustats", DEBUG_CPU_STATS, "Print CPU time spent in state atoms and driver calls at context destruction" },
    DEBUG_NAMED_VALUE_END
 };
 
@@ -50,6 +50,7 @@
 #include "st_context.h"
 #include "st_atom.h"
 #include "st_cb_bitmap.h"
+#include "st_cpu_stats.h"
 #include "st_debug.h"
 #include "st_draw.h"
 #include "st_program.h"
@@ -120,8 +121,10 @@ st_draw_gallium(struct gl_context *ctx,
                 unsigned num_draws)
 {
    struct st_context *st = st_context(ctx);
+   int64_t start = st_cpu_stats_begin(st, ST_CPU_STATS_DRAW_VBO);
 
    cso_draw_vbo(st->cso_context, info, drawid_offset, indirect, draws, num_draws);
+   st_cpu_stats_end(st, ST_CPU_STATS_DRAW_VBO, start);
 }
 
 static void
@@ -135,6 +138,7 @@ st_draw_gallium_multimode(struct gl_context *ctx,
 
    unsigned i, first;
    struct cso_context *cso = st->cso_context;
+   int64_t start = st_cpu_stats_begin(st, ST_CPU_STATS_DRAW_VBO);
 
    /* Find consecutive draws where mode doesn't vary. */
    for (i = 0, first = 0; i <= num_draws; i++) {
@@ -149,6 +153,7 @@ st_draw_gallium_multimode(struct gl_context *ctx,
          info->take_index_buffer_ownership = false;
       }
    }
+   st_cpu_stats_end(st, ST_CPU_STATS_DRAW_VBO, start);
 }
 
 static void
@@ -401,6 +406,7 @@ st_hw_select_draw_gallium(struct gl_context *ctx,
 {
    struct st_context *st = st_context(ctx);
    enum mesa_prim old_mode = info->mode;
+   int64_t start = st_cpu_stats_begin(st, ST_CPU_STATS_DRAW_VBO);
 
    if (st_draw_hw_select_prepare_common(ctx) &&
        /* Removing "const" is fine because we restore the changed mode
@@ -409,6 +415,7 @@ st_hw_select_draw_gallium(struct gl_context *ctx,
       cso_draw_vbo(st->cso_context, info, drawid_offset, indirect, draws,
                    num_draws);
    }
+   st_cpu_stats_end(st, ST_CPU_STATS_DRAW_VBO, start);
 
    ((struct pipe_draw_info*)info)->mode = old_mode;
 }
@@ -422,8 +429,12 @@ st_hw_select_draw_gallium_multimode(struct gl_context *ctx,
 {
    struct st_context *st = st_context(ctx);
 
-   if (!st_draw_hw_select_prepare_common(ctx))
+   int64_t start = st_cpu_stats_begin(st, ST_CPU_STATS_DRAW_VBO);
+
+   if (!st_draw_hw_select_prepare_common(ctx)) {
+      st_cpu_stats_end(st, ST_CPU_STATS_DRAW_VBO, start);
       return;
+   }
 
    unsigned i, first;
    struct cso_context *cso = st->cso_context;
@@ -444,6 +455,7 @@ st_hw_select_draw_gallium_multimode(struct gl_context *ctx,
          info->take_index_buffer_ownership = false;
       }
    }
+   st_cpu_stats_end(st, ST_CPU_STATS_DRAW_VBO, start);
 }
 
 void
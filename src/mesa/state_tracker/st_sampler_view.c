@@ -35,6 +35,7 @@
 #include "program/prog_instruction.h"
 
 #include "st_context.h"
+#include "st_cpu_stats.h"
 #include "st_sampler_view.h"
 #include "st_texture.h"
 #include "st_format.h"
@@ -72,9 +73,10 @@ get_sampler_view_reference(struct st_sampler_view *sv,
 }
 
 /**
- * Set the given view as the current context's view for the texture.
+ * Set the given view as the current context's view for the texture and the
+ * given glsl130_or_later/srgb_skip_decode combination.
  *
- * Overwrites any pre-existing view of the context.
+ * Overwrites any pre-existing view of the context with the same combination.
  *
  * Takes ownership of the view (i.e., stores the view without incrementing the
  * reference count).
@@ -103,8 +105,10 @@ st_texture_set_sampler_view(struct st_context *st,
 
       /* Is the array entry used ? */
       if (sv->view) {
-         /* check if the context matches */
-         if (sv->view->context == st->pipe) {
+         /* check if the context and the view key match */
+         if (sv->view->context == st->pipe &&
+             sv->glsl130_or_later == glsl130_or_later &&
+             sv->srgb_skip_decode == srgb_skip_decode) {
             st_remove_private_references(sv);
             pipe_sampler_view_reference(&sv->view, NULL);
             goto found;
@@ -115,7 +119,7 @@ st_texture_set_sampler_view(struct st_context *st,
       }
    }
 
-   /* Couldn't find a slot for our context, create a new one */
+   /* Couldn't find a slot for our context and key, create a new one */
    if (free) {
       sv = free;
    } else {
@@ -195,20 +199,29 @@ out:
 
 
 /**
- * Return the most-recently validated sampler view for the texture \p stObj
- * in the given context, if any.
+ * Return the validated sampler view for the texture \p stObj in the given
+ * context with the given glsl130_or_later/srgb_skip_decode combination,
+ * if any.
+ *
+ * A context can have one view per combination, so that shaders of different
+ * GLSL versions or samplers with different sRGB decode modes sampling the
+ * same texture don't recreate the view at every draw.
  *
  * Performs no additional validation.
  */
 struct st_sampler_view *
 st_texture_get_current_sampler_view(const struct st_context *st,
-                                    const struct gl_texture_object *stObj)
+                                    const struct gl_texture_object *stObj,
+                                    bool glsl130_or_later,
+                                    bool srgb_skip_decode)
 {
    struct st_sampler_views *views = p_atomic_read(&stObj->sampler_views);
 
    for (unsigned i = 0; i < views->count; ++i) {
       struct st_sampler_view *sv = &views->views[i];
-      if (sv->view && sv->view->context == st->pipe)
+      if (sv->view && sv->view->context == st->pipe &&
+          sv->glsl130_or_later == glsl130_or_later &&
+          sv->srgb_skip_decode == srgb_skip_decode)
          return sv;
    }
 
@@ -235,7 +248,6 @@ st_texture_release_context_sampler_view(struct st_context *st,
       if (sv->view && sv->view->context == st->pipe) {
          st_remove_private_references(sv);
          pipe_sampler_view_reference(&sv->view, NULL);
-         break;
       }
    }
    simple_mtx_unlock(&stObj->validate_mutex);
@@ -488,7 +500,12 @@ st_create_texture_sampler_view_from_stobj(struct st_context *st,
    templ.swizzle_b = GET_SWZ(swizzle, 2);
    templ.swizzle_a = GET_SWZ(swizzle, 3);
 
-   return st->pipe->create_sampler_view(st->pipe, texObj->pt, &templ);
+   int64_t start = st_cpu_stats_begin(st, ST_CPU_STATS_CREATE_SAMPLER_VIEW);
+   struct pipe_sampler_view *view =
+      st->pipe->create_sampler_view(st->pipe, texObj->pt, &templ);
+   st_cpu_stats_end(st, ST_CPU_STATS_CREATE_SAMPLER_VIEW, start);
+
+   return view;
 }
 
 struct pipe_sampler_view *
@@ -506,11 +523,10 @@ st_get_texture_sampler_view_from_stobj(struct st_context *st,
       srgb_skip_decode = true;
 
    simple_mtx_lock(&texObj->validate_mutex);
-   sv = st_texture_get_current_sampler_view(st, texObj);
+   sv = st_texture_get_current_sampler_view(st, texObj, glsl130_or_later,
+                                            srgb_skip_decode);
 
-   if (sv &&
-       sv->glsl130_or_later == glsl130_or_later &&
-       sv->srgb_skip_decode == srgb_skip_decode) {
+   if (sv) {
       /* Debug check: make sure that the sampler view's parameters are
        * what they're supposed to be.
        */
@@ -563,7 +579,7 @@ st_get_buffer_sampler_view_from_stobj(struct st_context *st,
    if (!stBuf || !stBuf->buffer)
       return NULL;
 
-   sv = st_texture_get_current_sampler_view(st, texObj);
+   sv = st_texture_get_current_sampler_view(st, texObj, false, false);
 
    struct pipe_resource *buf = stBuf->buffer;
 
@@ -68,7 +68,9 @@ st_delete_texture_sampler_views(struct st_context *st,
 
 struct st_sampler_view *
 st_texture_get_current_sampler_view(const struct st_context *st,
-                                    const struct gl_texture_object *stObj);
+                                    const struct gl_texture_object *stObj,
+                                    bool glsl130_or_later,
+                                    bool srgb_skip_decode);
 
 struct pipe_sampler_view *
 st_get_texture_sampler_view_from_stobj(struct st_context *st,
@@ -51,7 +51,8 @@ struct st_texture_image_transfer
 
 
 /**
- * Container for one context's validated sampler view.
+ * Container for one of a context's validated sampler views. A context has
+ * at most one view per glsl130_or_later/srgb_skip_decode combination.
  */
 struct st_sampler_view
 {
@@ -176,6 +176,13 @@ struct vbo_save_context {
    GLboolean dangling_attr_ref;
    GLboolean out_of_memory;  /**< True if last VBO allocation failed */
    bool no_current_update;
+
+   /* Display list playback keeps the VAO of a vertex list bound for the
+    * following vertex lists. These are the draw VAO states to restore.
+    */
+   bool playback_vao_bound;
+   struct gl_vertex_array_object *playback_saved_vao;
+   GLbitfield playback_saved_vp_input_filter;
 };
 
 GLboolean
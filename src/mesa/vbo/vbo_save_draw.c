@@ -203,6 +203,9 @@ vbo_save_playback_vertex_list_gallium(struct gl_context *ctx,
    if (!ctx->Const.HasDrawVertexState || ctx->RenderMode != GL_RENDER)
       return USE_SLOW_PATH;
 
+   /* This path restores the edge flag state from the draw VAO. */
+   vbo_save_playback_restore_draw_vao(ctx);
+
    const gl_vertex_processing_mode mode = ctx->VertexProgram._VPMode;
 
    /* This sets which vertex arrays are enabled, which determines
@@ -351,14 +354,25 @@ vbo_save_playback_vertex_list(struct gl_context *ctx, void *data, bool copy_to_c
    if (vbo_save_playback_vertex_list_gallium(ctx, node, copy_to_current) == DONE)
       return;
 
-   /* Save the Draw VAO before we override it. */
+   struct vbo_save_context *save = &vbo_context(ctx)->save;
    const gl_vertex_processing_mode mode = ctx->VertexProgram._VPMode;
    GLbitfield vao_filter = _vbo_get_vao_filter(mode);
-   struct gl_vertex_array_object *old_vao;
-   GLbitfield old_vp_input_filter;
+   struct gl_vertex_array_object *vao = node->cold->VAO[mode];
 
-   _mesa_save_and_set_draw_vao(ctx, node->cold->VAO[mode], vao_filter,
-                               &old_vao, &old_vp_input_filter);
+   /* Consecutive vertex lists usually share the VAO because their vertices
+    * are merged into the same buffer. Keep the VAO bound between them, so
+    * that vertex arrays aren't revalidated for every vertex list.
+    * execute_list restores the draw VAO before executing anything else.
+    */
+   if (!save->playback_vao_bound || ctx->Array._DrawVAO != vao ||
+       ctx->VertexProgram._VPModeInputFilter != vao_filter) {
+      /* Save the Draw VAO before we override it. */
+      vbo_save_playback_restore_draw_vao(ctx);
+      _mesa_save_and_set_draw_vao(ctx, vao, vao_filter,
+                                  &save->playback_saved_vao,
+                                  &save->playback_saved_vp_input_filter);
+      save->playback_vao_bound = true;
+   }
    _mesa_set_varying_vp_inputs(ctx, vao_filter &
                                ctx->Array._DrawVAO->_EnabledWithMapMode);
 
@@ -368,7 +382,7 @@ vbo_save_playback_vertex_list(struct gl_context *ctx, void *data, bool copy_to_c
 
    /* Return precomputed GL errors such as invalid shaders. */
    if (!ctx->ValidPrimMask) {
-      _mesa_restore_draw_vao(ctx, old_vao, old_vp_input_filter);
+      vbo_save_playback_restore_draw_vao(ctx);
       _mesa_error(ctx, ctx->DrawGLError, "glCallList");
       return;
    }
@@ -391,8 +405,24 @@ vbo_save_playback_vertex_list(struct gl_context *ctx, void *data, bool copy_to_c
                               node->num_draws);
    }
 
-   _mesa_restore_draw_vao(ctx, old_vao, old_vp_input_filter);
-
    if (copy_to_current)
       playback_copy_to_current(ctx, node);
 }
+
+/**
+ * Restore the draw VAO that vbo_save_playback_vertex_list replaced, if any.
+ * This must be called before executing anything but vertex lists.
+ */
+void
+vbo_save_playback_restore_draw_vao(struct gl_context *ctx)
+{
+   struct vbo_save_context *save = &vbo_context(ctx)->save;
+
+   if (!save->playback_vao_bound)
+      return;
+
+   _mesa_restore_draw_vao(ctx, save->playback_saved_vao,
+                          save->playback_saved_vp_input_filter);
+   save->playback_saved_vao = NULL;
+   save->playback_vao_bound = false;
+}
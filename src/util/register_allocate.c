@@ -72,9 +72,14 @@
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "blob.h"
+#include "disk_cache.h"
+#include "hash_table.h"
+#include "mesa-blake3.h"
 #include "ralloc.h"
+#include "simple_mtx.h"
 #include "util/bitset.h"
 #include "util/u_dynarray.h"
 #include "u_math.h"
@@ -393,6 +398,167 @@ ra_set_finalize(struct ra_regs *regs, unsigned int **q_values)
    }
 }
 
+static struct hash_table *q_values_tbl;
+static bool q_values_tbl_exited = false;
+static simple_mtx_t q_values_tbl_mtx = SIMPLE_MTX_INITIALIZER;
+
+static void
+q_values_tbl_fini(void)
+{
+   simple_mtx_lock(&q_values_tbl_mtx);
+   _mesa_hash_table_destroy(q_values_tbl, NULL);
+   q_values_tbl = NULL;
+   q_values_tbl_exited = true;
+   simple_mtx_unlock(&q_values_tbl_mtx);
+}
+
+static uint32_t
+q_values_key_hash(const void *key)
+{
+   return *(const uint32_t *)key;
+}
+
+static bool
+q_values_key_equal(const void *a, const void *b)
+{
+   return memcmp(a, b, sizeof(blake3_hash)) == 0;
+}
+
+/**
+ * Hashes everything about a not yet finalized register set that its q
+ * values are computed from.
+ */
+static void
+ra_set_compute_q_values_key(const struct ra_regs *regs, blake3_hash key)
+{
+   struct mesa_blake3 ctx;
+   _mesa_blake3_init(&ctx);
+
+   const size_t bitset_size = BITSET_WORDS(regs->count) * sizeof(BITSET_WORD);
+   const bool has_conflict_lists = regs->regs[0].conflict_list.mem_ctx != NULL;
+   bool all_contig = true;
+
+   _mesa_blake3_update(&ctx, &regs->count, sizeof(regs->count));
+   _mesa_blake3_update(&ctx, &regs->class_count, sizeof(regs->class_count));
+   _mesa_blake3_update(&ctx, &has_conflict_lists, sizeof(has_conflict_lists));
+
+   for (unsigned int c = 0; c < regs->class_count; c++) {
+      const struct ra_class *class = regs->classes[c];
+      _mesa_blake3_update(&ctx, &class->contig_len, sizeof(class->contig_len));
+      _mesa_blake3_update(&ctx, class->regs, bitset_size);
+      all_contig &= class->contig_len != 0;
+   }
+
+   if (!all_contig) {
+      for (unsigned int r = 0; r < regs->count; r++)
+         _mesa_blake3_update(&ctx, regs->regs[r].conflicts, bitset_size);
+   }
+
+   _mesa_blake3_final(&ctx, key);
+}
+
+static void
+ra_set_finalize_from_flat_q(struct ra_regs *regs, const unsigned int *q)
+{
+   unsigned int **q_values = malloc(regs->class_count * sizeof(*q_values));
+   if (!q_values) {
+      ra_set_finalize(regs, NULL);
+      return;
+   }
+
+   for (unsigned int b = 0; b < regs->class_count; b++)
+      q_values[b] = (unsigned int *)&q[b * regs->class_count];
+
+   ra_set_finalize(regs, q_values);
+   free(q_values);
+}
+
+/**
+ * Like ra_set_finalize(regs, NULL), but reuses the q values computed for an
+ * identical register set earlier in the process or, if a disk cache is
+ * given, by an earlier process.
+ *
+ * This lets drivers that build the same register sets for every screen or
+ * context skip the q value computation, which dominates register set setup
+ * for large sets.
+ */
+void
+ra_set_finalize_cached(struct ra_regs *regs, struct disk_cache *cache)
+{
+   const unsigned int class_count = regs->class_count;
+   const size_t q_size = class_count * class_count * sizeof(unsigned int);
+
+   blake3_hash key;
+   ra_set_compute_q_values_key(regs, key);
+
+   unsigned int *q = NULL;
+   simple_mtx_lock(&q_values_tbl_mtx);
+   if (q_values_tbl) {
+      struct hash_entry *entry = _mesa_hash_table_search(q_values_tbl, key);
+      if (entry)
+         q = entry->data;
+   }
+   simple_mtx_unlock(&q_values_tbl_mtx);
+
+   /* Entries are never removed before exit, so q stays valid once found. */
+   if (q) {
+      ra_set_finalize_from_flat_q(regs, q);
+      return;
+   }
+
+   cache_key disk_key;
+   void *disk_q = NULL;
+   if (cache) {
+      disk_cache_compute_key(cache, key, sizeof(key), disk_key);
+
+      size_t size;
+      disk_q = disk_cache_get(cache, disk_key, &size);
+      if (disk_q && size != q_size) {
+         free(disk_q);
+         disk_q = NULL;
+      }
+   }
+
+   if (disk_q) {
+      ra_set_finalize_from_flat_q(regs, disk_q);
+      free(disk_q);
+   } else {
+      ra_set_finalize(regs, NULL);
+   }
+
+   simple_mtx_lock(&q_values_tbl_mtx);
+   if (!q_values_tbl && !q_values_tbl_exited) {
+      q_values_tbl = _mesa_hash_table_create(NULL, q_values_key_hash,
+                                             q_values_key_equal);
+      if (q_values_tbl)
+         atexit(q_values_tbl_fini);
+   }
+   if (q_values_tbl && !_mesa_hash_table_search(q_values_tbl, key)) {
+      void *key_copy = ralloc_memdup(q_values_tbl, key, sizeof(key));
+      q = ralloc_size(q_values_tbl, q_size);
+      if (key_copy && q) {
+         for (unsigned int b = 0; b < class_count; b++) {
+            memcpy(&q[b * class_count], regs->classes[b]->q,
+                   class_count * sizeof(*q));
+         }
+         _mesa_hash_table_insert(q_values_tbl, key_copy, q);
+      }
+   }
+   simple_mtx_unlock(&q_values_tbl_mtx);
+
+   if (cache && !disk_q) {
+      unsigned int *data = malloc(q_size);
+      if (data) {
+         for (unsigned int b = 0; b < class_count; b++) {
+            memcpy(&data[b * class_count], regs->classes[b]->q,
+                   class_count * sizeof(*data));
+         }
+         disk_cache_put(cache, disk_key, data, q_size, NULL);
+         free(data);
+      }
+   }
+}
+
 void
 ra_set_serialize(const struct ra_regs *regs, struct blob *blob)
 {
@@ -829,23 +995,6 @@ ra_class_allocations_conflict(struct ra_class *c1, unsigned int r1,
    }
 }
 
-static struct ra_node *
-ra_find_conflicting_neighbor(struct ra_graph *g, unsigned int n, unsigned int r)
-{
-   util_dynarray_foreach(&g->nodes[n].adjacency_list, unsigned int, n2p) {
-      unsigned int n2 = *n2p;
-
-      /* If our adjacent node is in the stack, it's not allocated yet. */
-      if (!BITSET_TEST(g->tmp.in_stack, n2) &&
-          ra_class_allocations_conflict(g->regs->classes[g->nodes[n].class], r,
-                                        g->regs->classes[g->nodes[n2].class], g->nodes[n2].reg)) {
-         return &g->nodes[n2];
-      }
-   }
-
-   return NULL;
-}
-
 /* Computes a bitfield of what regs are available for a given register
  * selection.
  *
@@ -871,11 +1020,11 @@ ra_compute_available_regs(struct ra_graph *g, unsigned int n, BITSET_WORD *regs)
          if (c->contig_len) {
             int start = MAX2(0, (int)n2->reg - c->contig_len + 1);
             int end = MIN2(g->regs->count, n2->reg + n2c->contig_len);
-            for (unsigned i = start; i < end; i++)
-               BITSET_CLEAR(regs, i);
+            if (start < end)
+               BITSET_CLEAR_RANGE(regs, start, end - 1);
          } else {
-            for (int j = 0; j < BITSET_WORDS(g->regs->count); j++)
-               regs[j] &= ~g->regs->regs[n2->reg].conflicts[j];
+            __bitset_andnot(regs, regs, g->regs->regs[n2->reg].conflicts,
+                            BITSET_WORDS(g->regs->count));
          }
       }
    }
@@ -888,6 +1037,28 @@ ra_compute_available_regs(struct ra_graph *g, unsigned int n, BITSET_WORD *regs)
    return false;
 }
 
+/* Returns the first reg set in regs at or after start, wrapping around to
+ * the beginning of the set, or NO_REG if regs is empty.
+ */
+static unsigned int
+ra_find_available_reg(const BITSET_WORD *regs, unsigned int count,
+                      unsigned int start)
+{
+   const unsigned int words = BITSET_WORDS(count);
+   unsigned int i = BITSET_BITWORD(start);
+
+   BITSET_WORD word = regs[i] & ~(BITSET_BIT(start) - 1);
+   for (unsigned int w = 0; w <= words; w++) {
+      if (word)
+         return i * BITSET_WORDBITS + ffs(word) - 1;
+
+      i = (i + 1) % words;
+      word = regs[i];
+   }
+
+   return NO_REG;
+}
+
 /**
  * Pops nodes from the stack back into the graph, coloring them with
  * registers as they go.
@@ -898,59 +1069,38 @@ ra_compute_available_regs(struct ra_graph *g, unsigned int n, BITSET_WORD *regs)
 static bool
 ra_select(struct ra_graph *g)
 {
-   int start_search_reg = 0;
-   BITSET_WORD *select_regs = NULL;
-
-   if (g->select_reg_callback)
-      select_regs = malloc(BITSET_WORDS(g->regs->count) * sizeof(BITSET_WORD));
+   unsigned int start_search_reg = 0;
+   BITSET_WORD *select_regs =
+      malloc(BITSET_WORDS(g->regs->count) * sizeof(BITSET_WORD));
 
    while (g->tmp.stack_count != 0) {
-      unsigned int ri;
-      unsigned int r = -1;
+      unsigned int r;
       int n = g->tmp.stack[g->tmp.stack_count - 1];
-      struct ra_class *c = g->regs->classes[g->nodes[n].class];
 
       /* set this to false even if we return here so that
        * ra_get_best_spill_node() considers this node later.
        */
       BITSET_CLEAR(g->tmp.in_stack, n);
 
-      if (g->select_reg_callback) {
-         if (!ra_compute_available_regs(g, n, select_regs)) {
-            free(select_regs);
-            return false;
-         }
+      /* Build the set of regs not used by a member of the graph adjacent to
+       * us a whole word at a time, rather than probing each candidate reg
+       * against every neighbor.
+       */
+      if (!ra_compute_available_regs(g, n, select_regs)) {
+         free(select_regs);
+         return false;
+      }
 
+      if (g->select_reg_callback) {
          r = g->select_reg_callback(n, select_regs, g->select_reg_callback_data);
          assert(r < g->regs->count);
       } else {
-         /* Find the lowest-numbered reg which is not used by a member
-          * of the graph adjacent to us.
+         /* Find the lowest-numbered available reg, starting at
+          * start_search_reg.
           */
-         for (ri = 0; ri < g->regs->count; ri++) {
-            r = (start_search_reg + ri) % g->regs->count;
-            if (!reg_belongs_to_class(r, c))
-               continue;
-
-            struct ra_node *conflicting = ra_find_conflicting_neighbor(g, n, r);
-            if (!conflicting) {
-               /* Found a reg! */
-               break;
-            }
-            if (g->regs->classes[conflicting->class]->contig_len) {
-               /* Skip to point at the last base reg of the conflicting reg
-                * allocation -- the loop will increment us to check the next reg
-                * after the conflicting allocaiton.
-                */
-               unsigned conflicting_end = (conflicting->reg +
-                                           g->regs->classes[conflicting->class]->contig_len - 1);
-               assert(conflicting_end >= r);
-               ri += conflicting_end - r;
-            }
-         }
-
-         if (ri >= g->regs->count)
-            return false;
+         r = ra_find_available_reg(select_regs, g->regs->count,
+                                   start_search_reg % g->regs->count);
+         assert(r < g->regs->count);
       }
 
       g->nodes[n].reg = r;
@@ -41,6 +41,7 @@ struct ra_regs;
 
 struct blob;
 struct blob_reader;
+struct disk_cache;
 
 /* @{
  * Register set setup.
@@ -71,6 +72,7 @@ struct ra_class *ra_get_class_from_index(struct ra_regs *regs, unsigned int c);
 void ra_set_num_conflicts(struct ra_regs *regs, unsigned int class_a,
                           unsigned int class_b, unsigned int num_conflicts);
 void ra_set_finalize(struct ra_regs *regs, unsigned int **conflicts);
+void ra_set_finalize_cached(struct ra_regs *regs, struct disk_cache *cache);
 
 void ra_set_serialize(const struct ra_regs *regs, struct blob *blob);
 struct ra_regs *ra_set_deserialize(void *mem_ctx, struct blob_reader *blob);
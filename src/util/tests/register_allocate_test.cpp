@@ -149,6 +149,50 @@ TEST_F(ra_test, thumb_contigregs)
    thumb_checks(regs, 0, 0);
 }
 
+static struct ra_regs *
+alloc_thumb_contigregs(void *mem_ctx, unsigned reg96_count)
+{
+   struct ra_regs *regs = ra_alloc_reg_set(mem_ctx, 16, true);
+
+   struct ra_class *reg32low = ra_alloc_contig_reg_class(regs, 1);
+   for (int i = 0; i < 8; i++)
+      ra_class_add_reg(reg32low, i);
+
+   struct ra_class *reg64low = ra_alloc_contig_reg_class(regs, 2);
+   for (int i = 0; i < 8; i++)
+      ra_class_add_reg(reg64low, i);
+
+   struct ra_class *reg96 = ra_alloc_contig_reg_class(regs, 3);
+   for (unsigned i = 0; i < reg96_count; i++)
+      ra_class_add_reg(reg96, i);
+
+   return regs;
+}
+
+TEST_F(ra_test, finalize_cached)
+{
+   /* Miss, then hit in the process-wide cache. */
+   for (int i = 0; i < 2; i++) {
+      struct ra_regs *regs = alloc_thumb_contigregs(mem_ctx, 2);
+      ra_set_finalize_cached(regs, NULL);
+      thumb_checks(regs, 0, 0);
+   }
+
+   /* A set that differs only in class membership must not share q values. */
+   struct ra_regs *ref = alloc_thumb_contigregs(mem_ctx, 6);
+   ra_set_finalize(ref, NULL);
+
+   struct ra_regs *regs = alloc_thumb_contigregs(mem_ctx, 6);
+   ra_set_finalize_cached(regs, NULL);
+
+   for (unsigned b = 0; b < 3; b++) {
+      for (unsigned c = 0; c < 3; c++) {
+         EXPECT_EQ(ra_get_class_from_index(regs, b)->q[c],
+                   ra_get_class_from_index(ref, b)->q[c]);
+      }
+   }
+}
+
 TEST_F(ra_test, nonintersect_contigregs)
 {
    struct ra_regs *regs = ra_alloc_reg_set(mem_ctx, 16, true);
@@ -279,3 +323,107 @@ TEST_F(ra_test, serialization_roundtrip)
    blob_finish(&blob);
 }
 
+/* Checks that no two interfering nodes got conflicting registers. */
+static void
+check_allocation(struct ra_graph *g, const bool *interfere, unsigned count)
+{
+   for (unsigned i = 0; i < count; i++) {
+      for (unsigned j = i + 1; j < count; j++) {
+         if (!interfere[i * count + j])
+            continue;
+
+         EXPECT_FALSE(ra_class_allocations_conflict(ra_get_node_class(g, i),
+                                                    ra_get_node_reg(g, i),
+                                                    ra_get_node_class(g, j),
+                                                    ra_get_node_reg(g, j)))
+            << "nodes " << i << " and " << j << " interfere";
+      }
+   }
+}
+
+static void
+add_random_interference(struct ra_graph *g, bool *interfere, unsigned count,
+                        unsigned percent)
+{
+   /* Simple LCG so that the graph is the same on every run. */
+   uint32_t seed = 0x12345678;
+
+   for (unsigned i = 0; i < count; i++) {
+      for (unsigned j = i + 1; j < count; j++) {
+         seed = seed * 1103515245 + 12345;
+         if ((seed >> 16) % 100 < percent) {
+            ra_add_node_interference(g, i, j);
+            interfere[i * count + j] = true;
+         }
+      }
+   }
+}
+
+TEST_F(ra_test, allocate_contigregs)
+{
+   const unsigned reg_count = 64;
+   const unsigned node_count = 96;
+   struct ra_regs *regs = ra_alloc_reg_set(mem_ctx, reg_count, true);
+
+   struct ra_class *classes[3];
+   for (unsigned c = 0; c < 3; c++) {
+      const unsigned len = 1 << c;
+      classes[c] = ra_alloc_contig_reg_class(regs, len);
+      for (unsigned i = 0; i + len <= reg_count; i += len)
+         ra_class_add_reg(classes[c], i);
+   }
+
+   ra_set_finalize(regs, NULL);
+
+   for (unsigned round_robin = 0; round_robin < 2; round_robin++) {
+      if (round_robin)
+         ra_set_allocate_round_robin(regs);
+
+      struct ra_graph *g = ra_alloc_interference_graph(regs, node_count);
+      bool *interfere = rzalloc_array(mem_ctx, bool, node_count * node_count);
+
+      for (unsigned i = 0; i < node_count; i++)
+         ra_set_node_class(g, i, classes[i % 3]);
+
+      add_random_interference(g, interfere, node_count, 10);
+
+      ASSERT_TRUE(ra_allocate(g));
+      check_allocation(g, interfere, node_count);
+
+      ralloc_free(g);
+   }
+}
+
+TEST_F(ra_test, allocate_conflicting_regs)
+{
+   /* r0..31 are the real HW registers, followed by 16 pairs of them. */
+   const unsigned node_count = 64;
+   struct ra_regs *regs = ra_alloc_reg_set(mem_ctx, 32 + 16, true);
+
+   struct ra_class *reg32 = ra_alloc_reg_class(regs);
+   for (unsigned i = 0; i < 32; i++)
+      ra_class_add_reg(reg32, i);
+
+   struct ra_class *reg64 = ra_alloc_reg_class(regs);
+   for (unsigned i = 0; i < 16; i++) {
+      const unsigned vreg = 32 + i;
+      ra_class_add_reg(reg64, vreg);
+      ra_add_transitive_reg_conflict(regs, 2 * i, vreg);
+      ra_add_transitive_reg_conflict(regs, 2 * i + 1, vreg);
+   }
+
+   ra_set_finalize(regs, NULL);
+
+   struct ra_graph *g = ra_alloc_interference_graph(regs, node_count);
+   bool *interfere = rzalloc_array(mem_ctx, bool, node_count * node_count);
+
+   for (unsigned i = 0; i < node_count; i++)
+      ra_set_node_class(g, i, i % 4 == 0 ? reg64 : reg32);
+
+   add_random_interference(g, interfere, node_count, 15);
+
+   ASSERT_TRUE(ra_allocate(g));
+   check_allocation(g, interfere, node_count);
+
+   ralloc_free(g);
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#include "util/detect_arch.h"
+#include "util/os_time.h"
+#include "util/u_cpu_detect.h"
+#include "util/u_minmax_index.h"
+
+typedef void (*minmax_func)(const void *indices, unsigned count,
+                            unsigned index_size, bool restart,
+                            unsigned restart_index,
+                            unsigned *out_min, unsigned *out_max);
+
+struct minmax_impl {
+   const char *name;
+   minmax_func func;
+};
+
+static std::vector<minmax_impl>
+supported_impls()
+{
+   std::vector<minmax_impl> impls;
+   ASSERTED const struct util_cpu_caps_t *caps = util_get_cpu_caps();
+
+   impls.push_back({"c", util_get_min_max_index_c});
+#if defined(USE_SSE41)
+   if (caps->has_sse4_1)
+      impls.push_back({"sse41", util_get_min_max_index_sse41});
+   if (caps->has_avx2)
+      impls.push_back({"avx2", util_get_min_max_index_avx2});
+#elif (DETECT_ARCH_AARCH64 || DETECT_ARCH_ARM) && !defined(__SOFTFP__)
+   if (caps->has_neon)
+      impls.push_back({"neon", util_get_min_max_index_neon});
+#endif
+   impls.push_back({"dispatch", util_get_min_max_index});
+
+   return impls;
+}
+
+/* The reference, written independently of the implementations. */
+static void
+reference_min_max(const uint8_t *data, unsigned count, unsigned index_size,
+                  bool restart, unsigned restart_index,
+                  unsigned *out_min, unsigned *out_max, bool *out_any)
+{
+   unsigned min = ~0u, max = 0;
+   bool any = false;
+
+   for (unsigned i = 0; i < count; i++) {
+      unsigned index;
+
+      switch (index_size) {
+      case 1: index = data[i]; break;
+      case 2: index = ((const uint16_t *)data)[i]; break;
+      default: index = ((const uint32_t *)data)[i]; break;
+      }
+
+      if (restart && index == restart_index)
+         continue;
+
+      min = index < min ? index : min;
+      max = index > max ? index : max;
+      any = true;
+   }
+
+   *out_min = min;
+   *out_max = max;
+   *out_any = any;
+}
+
+static uint32_t
+next_random(uint32_t *state)
+{
+   /* xorshift32 */
+   *state ^= *state << 13;
+   *state ^= *state >> 17;
+   *state ^= *state << 5;
+   return *state;
+}
+
+class u_minmax_index_test : public ::testing::TestWithParam<unsigned> {
+};
+
+TEST_P(u_minmax_index_test, matches_reference)
+{
+   const unsigned index_size = GetParam();
+   const unsigned max_value = index_size == 4 ? ~0u :
+                              (1u << (index_size * 8)) - 1;
+   std::vector<minmax_impl> impls = supported_impls();
+   uint32_t seed = 0x12345678;
+
+   /* Extra space for the misaligned starts. */
+   std::vector<uint8_t> buffer((300 + 8) * index_size);
+
+   for (unsigned count = 0; count < 300; count += 1 + count / 16) {
+      for (unsigned misalign = 0; misalign < 8; misalign += 3) {
+         uint8_t *data = &buffer[misalign * index_size];
+
+         for (unsigned range = 0; range < 3; range++) {
+            /* Small ranges make restart indices frequent. */
+            unsigned mask = range == 0 ? 3 : range == 1 ? 0xff : max_value;
+            unsigned restart_index = range == 2 ? max_value : 2;
+
+            for (unsigned i = 0; i < count; i++) {
+               unsigned value = next_random(&seed) & mask;
+
+               switch (index_size) {
+               case 1: data[i] = value; break;
+               case 2: ((uint16_t *)data)[i] = value; break;
+               default: ((uint32_t *)data)[i] = value; break;
+               }
+            }
+
+            for (unsigned restart = 0; restart < 2; restart++) {
+               unsigned ref_min, ref_max;
+               bool any;
+
+               reference_min_max(data, count, index_size, restart,
+                                 restart_index, &ref_min, &ref_max, &any);
+
+               for (const minmax_impl &impl : impls) {
+                  unsigned min, max;
+
+                  impl.func(data, count, index_size, restart, restart_index,
+                            &min, &max);
+
+                  if (any) {
+                     EXPECT_EQ(min, ref_min)
+                        << impl.name << " count " << count
+                        << " restart " << restart;
+                     EXPECT_EQ(max, ref_max)
+                        << impl.name << " count " << count
+                        << " restart " << restart;
+                  } else {
+                     EXPECT_GT(min, max)
+                        << impl.name << " count " << count
+                        << " restart " << restart;
+                  }
+               }
+            }
+         }
+      }
+   }
+}
+
+TEST_P(u_minmax_index_test, restart_index_out_of_range)
+{
+   const unsigned index_size = GetParam();
+
+   if (index_size == 4)
+      GTEST_SKIP();
+
+   std::vector<uint8_t> buffer(64 * index_size, 0xff);
+   unsigned min, max;
+
+   /* A restart index that doesn't fit never matches. */
+   util_get_min_max_index(buffer.data(), 64, index_size, true, ~0u,
+                          &min, &max);
+
+   EXPECT_EQ(min, (1u << (index_size * 8)) - 1);
+   EXPECT_EQ(max, (1u << (index_size * 8)) - 1);
+}
+
+/* A microbenchmark. Run with --gtest_also_run_disabled_tests. */
+TEST_P(u_minmax_index_test, DISABLED_benchmark)
+{
+   const unsigned index_size = GetParam();
+   const unsigned count = 1 << 20;
+   std::vector<uint8_t> buffer(count * index_size);
+   uint32_t seed = 0x12345678;
+
+   for (uint8_t &b : buffer)
+      b = next_random(&seed);
+
+   for (const minmax_impl &impl : supported_impls()) {
+      for (unsigned restart = 0; restart < 2; restart++) {
+         unsigned min, max;
+         int64_t start = os_time_get_nano();
+
+         for (unsigned i = 0; i < 100; i++) {
+            impl.func(buffer.data(), count, index_size, restart, 0,
+                      &min, &max);
+         }
+
+         double seconds = (os_time_get_nano() - start) / 1e9;
+         printf("%u-byte indices, %-8s %s: %8.2f GB/s\n", index_size,
+                impl.name, restart ? "restart   " : "no restart",
+                100.0 * buffer.size() / seconds / 1e9);
+      }
+   }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+   index_sizes, u_minmax_index_test, ::testing::Values(1u, 2u, 4u),
+   [](const ::testing::TestParamInfo<unsigned> &info) {
+      return std::to_string(info.param) + "byte";
+   });
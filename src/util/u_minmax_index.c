@@ -0,0 +1,96 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdint.h>
+
+#include "util/detect_arch.h"
+#include "util/macros.h"
+#include "util/u_cpu_detect.h"
+#include "util/u_minmax_index.h"
+
+#define MINMAX_C(type)                                               \
+   do {                                                              \
+      const type *p = (const type *)indices;                         \
+      if (restart) {                                                 \
+         for (unsigned i = 0; i < count; i++) {                      \
+            if (p[i] != restart_index) {                             \
+               min = MIN2(min, p[i]);                                \
+               max = MAX2(max, p[i]);                                \
+            }                                                        \
+         }                                                           \
+      } else {                                                       \
+         for (unsigned i = 0; i < count; i++) {                      \
+            min = MIN2(min, p[i]);                                   \
+            max = MAX2(max, p[i]);                                   \
+         }                                                           \
+      }                                                              \
+   } while (0)
+
+void
+util_get_min_max_index_c(const void *indices, unsigned count,
+                         unsigned index_size, bool restart,
+                         unsigned restart_index,
+                         unsigned *out_min, unsigned *out_max)
+{
+   unsigned min = ~0u, max = 0;
+
+   switch (index_size) {
+   case 4:
+      MINMAX_C(uint32_t);
+      break;
+   case 2:
+      MINMAX_C(uint16_t);
+      break;
+   case 1:
+      MINMAX_C(uint8_t);
+      break;
+   default:
+      unreachable("invalid index size");
+   }
+
+   *out_min = min;
+   *out_max = max;
+}
+
+/* Below this count, the SIMD kernels aren't faster. */
+#define MINMAX_SIMD_THRESHOLD 32
+
+void
+util_get_min_max_index(const void *indices, unsigned count,
+                       unsigned index_size, bool restart,
+                       unsigned restart_index,
+                       unsigned *out_min, unsigned *out_max)
+{
+   /* A restart index that doesn't fit into the index size never matches. */
+   if (restart && index_size < 4 &&
+       restart_index > u_uintN_max(index_size * 8))
+      restart = false;
+
+   if (count >= MINMAX_SIMD_THRESHOLD) {
+      ASSERTED const struct util_cpu_caps_t *caps = util_get_cpu_caps();
+
+#if defined(USE_SSE41)
+      if (caps->has_avx2) {
+         util_get_min_max_index_avx2(indices, count, index_size, restart,
+                                     restart_index, out_min, out_max);
+         return;
+      }
+      if (caps->has_sse4_1) {
+         util_get_min_max_index_sse41(indices, count, index_size, restart,
+                                      restart_index, out_min, out_max);
+         return;
+      }
+#elif (DETECT_ARCH_AARCH64 || DETECT_ARCH_ARM) && !defined(__SOFTFP__)
+      if (caps->has_neon) {
+         util_get_min_max_index_neon(indices, count, index_size, restart,
+                                     restart_index, out_min, out_max);
+         return;
+      }
+#endif
+   }
+
+   util_get_min_max_index_c(indices, count, index_size, restart,
+                            restart_index, out_min, out_max);
+}
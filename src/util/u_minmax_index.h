@@ -0,0 +1,60 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef U_MINMAX_INDEX_H
+#define U_MINMAX_INDEX_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compute the smallest and the largest of "count" indices of index_size
+ * (1, 2 or 4) bytes, ignoring indices equal to restart_index if "restart"
+ * is set. If there is no index to consider, *out_min > *out_max.
+ *
+ * Uses AVX2, SSE4.1 or NEON when the CPU supports them.
+ */
+void
+util_get_min_max_index(const void *indices, unsigned count,
+                       unsigned index_size, bool restart,
+                       unsigned restart_index,
+                       unsigned *out_min, unsigned *out_max);
+
+/* The implementations util_get_min_max_index chooses from. They are
+ * exposed for testing and must only be called if the CPU supports them.
+ * "restart_index" must fit in index_size bytes if "restart" is set.
+ */
+void
+util_get_min_max_index_c(const void *indices, unsigned count,
+                         unsigned index_size, bool restart,
+                         unsigned restart_index,
+                         unsigned *out_min, unsigned *out_max);
+
+void
+util_get_min_max_index_sse41(const void *indices, unsigned count,
+                             unsigned index_size, bool restart,
+                             unsigned restart_index,
+                             unsigned *out_min, unsigned *out_max);
+
+void
+util_get_min_max_index_avx2(const void *indices, unsigned count,
+                            unsigned index_size, bool restart,
+                            unsigned restart_index,
+                            unsigned *out_min, unsigned *out_max);
+
+void
+util_get_min_max_index_neon(const void *indices, unsigned count,
+                            unsigned index_size, bool restart,
+                            unsigned restart_index,
+                            unsigned *out_min, unsigned *out_max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U_MINMAX_INDEX_H */
@@ -0,0 +1,86 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifdef USE_SSE41
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#include "util/macros.h"
+#include "util/u_minmax_index.h"
+
+/* Restart indices are replaced by all ones for the minimum and by zero for
+ * the maximum, which doesn't change the result. The remaining indices are
+ * handled by the C loop.
+ */
+#define MINMAX_AVX2(type, bits)                                                \
+   do {                                                                        \
+      const type *p = (const type *)indices;                                   \
+      const unsigned lanes = sizeof(__m256i) / sizeof(type);                   \
+      __m256i vmin = _mm256_set1_epi32(-1);                                    \
+      __m256i vmax = _mm256_setzero_si256();                                   \
+      unsigned i = 0;                                                          \
+                                                                               \
+      if (restart) {                                                           \
+         __m256i vrestart = _mm256_set1_epi##bits((type)restart_index);        \
+         for (; i + lanes <= count; i += lanes) {                              \
+            __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));          \
+            __m256i is_restart = _mm256_cmpeq_epi##bits(v, vrestart);          \
+            vmin = _mm256_min_epu##bits(vmin, _mm256_or_si256(v, is_restart)); \
+            vmax = _mm256_max_epu##bits(vmax,                                  \
+                                        _mm256_andnot_si256(is_restart, v));   \
+         }                                                                     \
+      } else {                                                                 \
+         for (; i + lanes <= count; i += lanes) {                              \
+            __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));          \
+            vmin = _mm256_min_epu##bits(vmin, v);                              \
+            vmax = _mm256_max_epu##bits(vmax, v);                              \
+         }                                                                     \
+      }                                                                        \
+                                                                               \
+      type mins[sizeof(__m256i) / sizeof(type)];                               \
+      type maxs[sizeof(__m256i) / sizeof(type)];                               \
+      _mm256_storeu_si256((__m256i *)mins, vmin);                              \
+      _mm256_storeu_si256((__m256i *)maxs, vmax);                              \
+      for (unsigned j = 0; j < lanes; j++) {                                   \
+         min = MIN2(min, mins[j]);                                             \
+         max = MAX2(max, maxs[j]);                                             \
+      }                                                                        \
+                                                                               \
+      for (; i < count; i++) {                                                 \
+         if (!restart || p[i] != restart_index) {                              \
+            min = MIN2(min, p[i]);                                             \
+            max = MAX2(max, p[i]);                                             \
+         }                                                                     \
+      }                                                                        \
+   } while (0)
+
+void
+util_get_min_max_index_avx2(const void *indices, unsigned count,
+                             unsigned index_size, bool restart,
+                             unsigned restart_index,
+                             unsigned *out_min, unsigned *out_max)
+{
+   unsigned min = ~0u, max = 0;
+
+   switch (index_size) {
+   case 4:
+      MINMAX_AVX2(uint32_t, 32);
+      break;
+   case 2:
+      MINMAX_AVX2(uint16_t, 16);
+      break;
+   case 1:
+      MINMAX_AVX2(uint8_t, 8);
+      break;
+   default:
+      unreachable("invalid index size");
+   }
+
+   *out_min = min;
+   *out_max = max;
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "util/detect_arch.h"
+
+#if (DETECT_ARCH_AARCH64 || DETECT_ARCH_ARM) && !defined(__SOFTFP__)
+
+/* armhf builds default to vfp, not neon, and refuses to compile neon intrinsics
+ * unless you tell it "no really".
+ */
+#if DETECT_ARCH_ARM
+#pragma GCC target ("fpu=neon")
+#endif
+
+#include <arm_neon.h>
+#include <stdint.h>
+
+#include "util/macros.h"
+#include "util/u_minmax_index.h"
+
+/* Restart indices are replaced by all ones for the minimum and by zero for
+ * the maximum, which doesn't change the result. The remaining indices are
+ * handled by the C loop.
+ */
+#define MINMAX_NEON(type, bits, lanes)                                        \
+   do {                                                                       \
+      const type *p = (const type *)indices;                                  \
+      uint##bits##x##lanes##_t vmin = vdupq_n_u##bits((type)~0u);             \
+      uint##bits##x##lanes##_t vmax = vdupq_n_u##bits(0);                     \
+      unsigned i = 0;                                                         \
+                                                                              \
+      if (restart) {                                                          \
+         uint##bits##x##lanes##_t vrestart =                                  \
+            vdupq_n_u##bits((type)restart_index);                             \
+         for (; i + lanes <= count; i += lanes) {                             \
+            uint##bits##x##lanes##_t v = vld1q_u##bits(p + i);                \
+            uint##bits##x##lanes##_t is_restart = vceqq_u##bits(v, vrestart); \
+            vmin = vminq_u##bits(vmin, vorrq_u##bits(v, is_restart));         \
+            vmax = vmaxq_u##bits(vmax, vbicq_u##bits(v, is_restart));         \
+         }                                                                    \
+      } else {                                                                \
+         for (; i + lanes <= count; i += lanes) {                             \
+            uint##bits##x##lanes##_t v = vld1q_u##bits(p + i);                \
+            vmin = vminq_u##bits(vmin, v);                                    \
+            vmax = vmaxq_u##bits(vmax, v);                                    \
+         }                                                                    \
+      }                                                                       \
+                                                                              \
+      type mins[lanes], maxs[lanes];                                          \
+      vst1q_u##bits(mins, vmin);                                              \
+      vst1q_u##bits(maxs, vmax);                                              \
+      for (unsigned j = 0; j < lanes; j++) {                                  \
+         min = MIN2(min, mins[j]);                                            \
+         max = MAX2(max, maxs[j]);                                            \
+      }                                                                       \
+                                                                              \
+      for (; i < count; i++) {                                                \
+         if (!restart || p[i] != restart_index) {                             \
+            min = MIN2(min, p[i]);                                            \
+            max = MAX2(max, p[i]);                                            \
+         }                                                                    \
+      }                                                                       \
+   } while (0)
+
+void
+util_get_min_max_index_neon(const void *indices, unsigned count,
+                            unsigned index_size, bool restart,
+                            unsigned restart_index,
+                            unsigned *out_min, unsigned *out_max)
+{
+   unsigned min = ~0u, max = 0;
+
+   switch (index_size) {
+   case 4:
+      MINMAX_NEON(uint32_t, 32, 4);
+      break;
+   case 2:
+      MINMAX_NEON(uint16_t, 16, 8);
+      break;
+   case 1:
+      MINMAX_NEON(uint8_t, 8, 16);
+      break;
+   default:
+      unreachable("invalid index size");
+   }
+
+   *out_min = min;
+   *out_max = max;
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifdef USE_SSE41
+
+#include <smmintrin.h>
+#include <stdint.h>
+
+#include "util/macros.h"
+#include "util/u_minmax_index.h"
+
+/* Restart indices are replaced by all ones for the minimum and by zero for
+ * the maximum, which doesn't change the result. The remaining indices are
+ * handled by the C loop.
+ */
+#define MINMAX_SSE41(type, bits)                                               \
+   do {                                                                        \
+      const type *p = (const type *)indices;                                   \
+      const unsigned lanes = sizeof(__m128i) / sizeof(type);                   \
+      __m128i vmin = _mm_set1_epi32(-1);                                       \
+      __m128i vmax = _mm_setzero_si128();                                      \
+      unsigned i = 0;                                                          \
+                                                                               \
+      if (restart) {                                                           \
+         __m128i vrestart = _mm_set1_epi##bits((type)restart_index);           \
+         for (; i + lanes <= count; i += lanes) {                              \
+            __m128i v = _mm_loadu_si128((const __m128i *)(p + i));             \
+            __m128i is_restart = _mm_cmpeq_epi##bits(v, vrestart);             \
+            vmin = _mm_min_epu##bits(vmin, _mm_or_si128(v, is_restart));       \
+            vmax = _mm_max_epu##bits(vmax, _mm_andnot_si128(is_restart, v));   \
+         }                                                                     \
+      } else {                                                                 \
+         for (; i + lanes <= count; i += lanes) {                              \
+            __m128i v = _mm_loadu_si128((const __m128i *)(p + i));             \
+            vmin = _mm_min_epu##bits(vmin, v);                                 \
+            vmax = _mm_max_epu##bits(vmax, v);                                 \
+         }                                                                     \
+      }                                                                        \
+                                                                               \
+      type mins[sizeof(__m128i) / sizeof(type)];                               \
+      type maxs[sizeof(__m128i) / sizeof(type)];                               \
+      _mm_storeu_si128((__m128i *)mins, vmin);                                 \
+      _mm_storeu_si128((__m128i *)maxs, vmax);                                 \
+      for (unsigned j = 0; j < lanes; j++) {                                   \
+         min = MIN2(min, mins[j]);                                             \
+         max = MAX2(max, maxs[j]);                                             \
+      }                                                                        \
+                                                                               \
+      for (; i < count; i++) {                                                 \
+         if (!restart || p[i] != restart_index) {                              \
+            min = MIN2(min, p[i]);                                             \
+            max = MAX2(max, p[i]);                                             \
+         }                                                                     \
+      }                                                                        \
+   } while (0)
+
+void
+util_get_min_max_index_sse41(const void *indices, unsigned count,
+                             unsigned index_size, bool restart,
+                             unsigned restart_index,
+                             unsigned *out_min, unsigned *out_max)
+{
+   unsigned min = ~0u, max = 0;
+
+   switch (index_size) {
+   case 4:
+      MINMAX_SSE41(uint32_t, 32);
+      break;
+   case 2:
+      MINMAX_SSE41(uint16_t, 16);
+      break;
+   case 1:
+      MINMAX_SSE41(uint8_t, 8);
+      break;
+   default:
+      unreachable("invalid index size");
+   }
+
+   *out_min = min;
+   *out_max = max;
+}
+
+#endif